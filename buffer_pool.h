@@ -0,0 +1,418 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+#include <mutex>
+
+// ------------------------------- VECTOR BUFFER POOL -----------------------------------
+
+// Счётчики пула. Блоки, выданные повторно из кэша потока или общего списка, считаются
+// попаданиями, выделенные из кучи - промахами
+struct BufferPoolStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    // блоки, возвращённые в пул
+    size_t returns = 0;
+    // запросы больше MAX_BLOCK_SIZE, которые обслуживаются кучей напрямую
+    size_t oversized = 0;
+
+    // доля попаданий среди запросов, обслуженных пулом
+    double HitRate() const noexcept {
+        const size_t total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+    }
+};
+
+/* Пул освобождённых буферов векторов, разбитых на классы размеров - степени двойки от
+   MIN_BLOCK_SIZE до MAX_BLOCK_SIZE байт. Освобождённый блок попадает в кэш текущего потока
+   и выдаётся повторно без обращения к куче и без блокировок. Если в кэше потока слишком
+   много блоков одного класса, половина из них переносится в общий список класса, а при
+   пустом кэше поток забирает из общего списка сразу пачку блоков. При завершении потока
+   его кэш переносится в общий список. Блоки освобождаются в кучу только методом Trim */
+class VectorBufferPool {
+public:
+    static constexpr size_t MIN_BLOCK_SIZE = 64;
+    static constexpr size_t MAX_BLOCK_SIZE = size_t{1} << 20;
+    static constexpr size_t NUM_CLASSES = 15;
+    // число блоков одного класса в кэше потока, при превышении которого кэш делится с общим списком
+    static constexpr size_t THREAD_CACHE_LIMIT = 32;
+    static_assert(MIN_BLOCK_SIZE << (NUM_CLASSES - 1) == MAX_BLOCK_SIZE);
+
+    static VectorBufferPool& Instance();
+
+    VectorBufferPool(const VectorBufferPool&) = delete;
+    VectorBufferPool& operator=(const VectorBufferPool&) = delete;
+
+    // Выделяет блок не меньше bytes байт, выровненный как результат operator new
+    void* Allocate(size_t bytes);
+    // Возвращает в пул блок, выделенный Allocate с тем же bytes
+    void Deallocate(void *block, size_t bytes) noexcept;
+
+    // Заранее выделяет count блоков под буферы размером bytes и помещает их в общий список,
+    // чтобы множество векторов одинакового размера создавалось без обращений к куче
+    void Reserve(size_t bytes, size_t count);
+    // Освобождает в кучу блоки общих списков и кэша текущего потока
+    void Trim() noexcept;
+
+    // Кэши потоков публикуют счётчики пачками, поэтому, пока другие потоки работают с пулом,
+    // значения приблизительные. Счётчики текущего потока учитываются полностью
+    BufferPoolStats Stats() const noexcept;
+    void ResetStats() noexcept;
+
+    // размер блока, выделяемого под запрос bytes, или 0 для запросов больше MAX_BLOCK_SIZE
+    static size_t BlockSize(size_t bytes) noexcept;
+
+private:
+    VectorBufferPool() = default;
+
+    // освобождённый блок хранит указатель на следующий блок списка в своей памяти
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    struct FreeList {
+        FreeBlock *head = nullptr;
+        size_t count = 0;
+
+        void Push(void *block) noexcept;
+        void* Pop() noexcept;
+        // переносит в other не более count блоков
+        void MoveTo(FreeList &other, size_t count) noexcept;
+        void Release() noexcept;
+    };
+
+    // общий список класса занимает отдельные кэш-линии, чтобы блокировки классов не мешали друг другу
+    struct alignas(CACHE_LINE_SIZE) SharedList {
+        std::mutex mutex;
+        FreeList blocks;
+    };
+
+    struct Counters {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t returns = 0;
+    };
+
+    struct ThreadCache {
+        ThreadCache() noexcept = default;
+        ThreadCache(const ThreadCache&) = delete;
+        ThreadCache& operator=(const ThreadCache&) = delete;
+        ~ThreadCache();
+
+        // false после разрушения кэша при завершении потока
+        static bool& Alive() noexcept;
+
+        FreeList lists[NUM_CLASSES];
+        Counters counters;
+        // операций с момента последней публикации счётчиков
+        size_t pending = 0;
+    };
+
+    // число операций кэша потока между публикациями счётчиков
+    static constexpr size_t STATS_BATCH = 256;
+
+    SharedList shared_[NUM_CLASSES];
+    std::atomic<size_t> hits_{0};
+    std::atomic<size_t> misses_{0};
+    std::atomic<size_t> returns_{0};
+    std::atomic<size_t> oversized_{0};
+
+    static size_t ClassIndex(size_t bytes) noexcept;
+    // кэш текущего потока или nullptr, если он уже разрушен при завершении потока
+    static ThreadCache* LocalCache() noexcept;
+
+    void* AllocateShared(size_t index);
+    void DeallocateShared(void *block, size_t index) noexcept;
+    void Publish(ThreadCache &cache) noexcept;
+    void CountOperation(ThreadCache &cache) noexcept;
+
+}; // class VectorBufferPool
+
+inline VectorBufferPool& VectorBufferPool::Instance() {
+    // пул не разрушается, чтобы кэши потоков и векторы в статических объектах могли
+    // возвращать в него блоки при завершении программы
+    static auto *instance = new VectorBufferPool();
+    return *instance;
+}
+
+inline void* VectorBufferPool::Allocate(size_t bytes) {
+    if (bytes > MAX_BLOCK_SIZE) {
+        oversized_.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(bytes);
+    }
+    const size_t index = ClassIndex(bytes);
+    ThreadCache *cache = LocalCache();
+    if (cache == nullptr) {
+        return AllocateShared(index);
+    }
+    FreeList &local = cache->lists[index];
+    if (local.count == 0) {
+        SharedList &shared = shared_[index];
+        std::lock_guard lock(shared.mutex);
+        shared.blocks.MoveTo(local, THREAD_CACHE_LIMIT / 2);
+    }
+    void *block = local.Pop();
+    if (block != nullptr) {
+        ++cache->counters.hits;
+    } else {
+        block = ::operator new(MIN_BLOCK_SIZE << index);
+        ++cache->counters.misses;
+    }
+    CountOperation(*cache);
+    return block;
+}
+
+inline void VectorBufferPool::Deallocate(void *block, size_t bytes) noexcept {
+    if (block == nullptr) {
+        return;
+    }
+    if (bytes > MAX_BLOCK_SIZE) {
+        ::operator delete(block);
+        return;
+    }
+    const size_t index = ClassIndex(bytes);
+    ThreadCache *cache = LocalCache();
+    if (cache == nullptr) {
+        DeallocateShared(block, index);
+        return;
+    }
+    FreeList &local = cache->lists[index];
+    local.Push(block);
+    ++cache->counters.returns;
+    if (local.count > THREAD_CACHE_LIMIT) {
+        SharedList &shared = shared_[index];
+        std::lock_guard lock(shared.mutex);
+        local.MoveTo(shared.blocks, THREAD_CACHE_LIMIT / 2);
+    }
+    CountOperation(*cache);
+}
+
+inline void VectorBufferPool::Reserve(size_t bytes, size_t count) {
+    if (bytes > MAX_BLOCK_SIZE || count == 0) {
+        return;
+    }
+    const size_t index = ClassIndex(bytes);
+    // блоки выделяются вне блокировки и добавляются в общий список одной пачкой
+    FreeList reserved;
+    try {
+        for (size_t i = 0; i < count; ++i) {
+            reserved.Push(::operator new(MIN_BLOCK_SIZE << index));
+        }
+    } catch (...) {
+        reserved.Release();
+        throw;
+    }
+    SharedList &shared = shared_[index];
+    std::lock_guard lock(shared.mutex);
+    reserved.MoveTo(shared.blocks, reserved.count);
+}
+
+inline void VectorBufferPool::Trim() noexcept {
+    if (ThreadCache *cache = LocalCache()) {
+        for (FreeList &local : cache->lists) {
+            local.Release();
+        }
+    }
+    for (SharedList &shared : shared_) {
+        FreeList blocks;
+        {
+            std::lock_guard lock(shared.mutex);
+            shared.blocks.MoveTo(blocks, shared.blocks.count);
+        }
+        blocks.Release();
+    }
+}
+
+inline BufferPoolStats VectorBufferPool::Stats() const noexcept {
+    BufferPoolStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.returns = returns_.load(std::memory_order_relaxed);
+    stats.oversized = oversized_.load(std::memory_order_relaxed);
+    if (const ThreadCache *cache = LocalCache()) {
+        stats.hits += cache->counters.hits;
+        stats.misses += cache->counters.misses;
+        stats.returns += cache->counters.returns;
+    }
+    return stats;
+}
+
+inline void VectorBufferPool::ResetStats() noexcept {
+    if (ThreadCache *cache = LocalCache()) {
+        cache->counters = Counters();
+        cache->pending = 0;
+    }
+    hits_.store(0, std::memory_order_relaxed);
+    misses_.store(0, std::memory_order_relaxed);
+    returns_.store(0, std::memory_order_relaxed);
+    oversized_.store(0, std::memory_order_relaxed);
+}
+
+inline size_t VectorBufferPool::BlockSize(size_t bytes) noexcept {
+    return bytes > MAX_BLOCK_SIZE ? 0 : MIN_BLOCK_SIZE << ClassIndex(bytes);
+}
+
+inline size_t VectorBufferPool::ClassIndex(size_t bytes) noexcept {
+    assert(bytes <= MAX_BLOCK_SIZE);
+    size_t index = 0;
+    while ((MIN_BLOCK_SIZE << index) < bytes) {
+        ++index;
+    }
+    return index;
+}
+
+inline VectorBufferPool::ThreadCache* VectorBufferPool::LocalCache() noexcept {
+    // к кэшу нельзя обращаться после его разрушения, например, из деструкторов других
+    // thread_local объектов, поэтому признак хранится в отдельной тривиальной переменной
+    if (!ThreadCache::Alive()) {
+        return nullptr;
+    }
+    thread_local ThreadCache cache;
+    return &cache;
+}
+
+inline void* VectorBufferPool::AllocateShared(size_t index) {
+    SharedList &shared = shared_[index];
+    void *block = nullptr;
+    {
+        std::lock_guard lock(shared.mutex);
+        block = shared.blocks.Pop();
+    }
+    if (block != nullptr) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return block;
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(MIN_BLOCK_SIZE << index);
+}
+
+inline void VectorBufferPool::DeallocateShared(void *block, size_t index) noexcept {
+    SharedList &shared = shared_[index];
+    std::lock_guard lock(shared.mutex);
+    shared.blocks.Push(block);
+    returns_.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void VectorBufferPool::Publish(ThreadCache &cache) noexcept {
+    hits_.fetch_add(cache.counters.hits, std::memory_order_relaxed);
+    misses_.fetch_add(cache.counters.misses, std::memory_order_relaxed);
+    returns_.fetch_add(cache.counters.returns, std::memory_order_relaxed);
+    cache.counters = Counters();
+    cache.pending = 0;
+}
+
+inline void VectorBufferPool::CountOperation(ThreadCache &cache) noexcept {
+    if (++cache.pending == STATS_BATCH) {
+        Publish(cache);
+    }
+}
+
+inline VectorBufferPool::ThreadCache::~ThreadCache() {
+    VectorBufferPool &pool = Instance();
+    for (size_t index = 0; index < NUM_CLASSES; ++index) {
+        if (lists[index].count != 0) {
+            SharedList &shared = pool.shared_[index];
+            std::lock_guard lock(shared.mutex);
+            lists[index].MoveTo(shared.blocks, lists[index].count);
+        }
+    }
+    pool.Publish(*this);
+    Alive() = false;
+}
+
+inline bool& VectorBufferPool::ThreadCache::Alive() noexcept {
+    thread_local bool alive = true;
+    return alive;
+}
+
+inline void VectorBufferPool::FreeList::Push(void *block) noexcept {
+    head = new (block) FreeBlock{head};
+    ++count;
+}
+
+inline void* VectorBufferPool::FreeList::Pop() noexcept {
+    if (head == nullptr) {
+        return nullptr;
+    }
+    FreeBlock *block = std::exchange(head, head->next);
+    --count;
+    return block;
+}
+
+inline void VectorBufferPool::FreeList::MoveTo(FreeList &other, size_t count) noexcept {
+    for (size_t i = 0; i < count && head != nullptr; ++i) {
+        other.Push(Pop());
+    }
+}
+
+inline void VectorBufferPool::FreeList::Release() noexcept {
+    while (head != nullptr) {
+        ::operator delete(Pop());
+    }
+}
+
+// ------------------------------- POOLED ALLOCATOR -------------------------------------
+
+// Аллокатор, берущий буферы из VectorBufferPool::Instance() и возвращающий их туда же.
+// Буферы типов с выравниванием больше, чем у operator new, выделяются напрямую из кучи
+template <typename T>
+class PooledAllocator {
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    PooledAllocator() noexcept = default;
+    template <typename U>
+    PooledAllocator(const PooledAllocator<U>& /*other*/) noexcept {}
+
+    T* allocate(size_t n);
+    void deallocate(T *buf, size_t n) noexcept;
+
+    template <typename U>
+    bool operator==(const PooledAllocator<U>& /*other*/) const noexcept {
+        return true;
+    }
+    template <typename U>
+    bool operator!=(const PooledAllocator<U>& /*other*/) const noexcept {
+        return false;
+    }
+
+private:
+    static constexpr bool POOLED = alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+}; // class PooledAllocator
+
+template <typename T>
+T* PooledAllocator<T>::allocate(size_t n) {
+    if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+        throw std::bad_array_new_length();
+    }
+    if constexpr (POOLED) {
+        return static_cast<T*>(VectorBufferPool::Instance().Allocate(n * sizeof(T)));
+    } else {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+    }
+}
+
+template <typename T>
+void PooledAllocator<T>::deallocate(T *buf, size_t n) noexcept {
+    if constexpr (POOLED) {
+        VectorBufferPool::Instance().Deallocate(static_cast<void*>(buf), n * sizeof(T));
+    } else {
+        ::operator delete(static_cast<void*>(buf), std::align_val_t{alignof(T)});
+    }
+}
+
+// Ёмкость, выбранная политикой Base, увеличивается до размера блока пула,
+// чтобы память блока не пропадала
+template <typename Base = DoublingGrowth>
+struct PoolBlockGrowth {
+    static constexpr bool USE_USABLE_SIZE = false;
+    static size_t NextCapacity(size_t capacity, size_t required, size_t elem_size) noexcept {
+        const size_t next = Base::NextCapacity(capacity, required, elem_size);
+        return std::max(next, VectorBufferPool::BlockSize(next * elem_size) / elem_size);
+    }
+};
+
+// Вектор, буферы которого переиспользуются через VectorBufferPool
+template <typename T, typename Growth = PoolBlockGrowth<>>
+using PooledVector = Vector<T, PooledAllocator<T>, Growth>;
@@ -0,0 +1,202 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+
+// -------------------------------- CONCURRENT VECTOR -----------------------------------
+
+// Вектор, в конец которого элементы могут одновременно добавлять несколько потоков без блокировок.
+// Элементы хранятся в сегментах RawMemory, ёмкость каждого следующего сегмента вдвое больше
+// предыдущей, поэтому при росте элементы не переносятся и их адреса не меняются.
+// Место под элемент резервируется атомарным счётчиком, а о завершении конструирования элемента
+// сообщает его флаг готовности. Когда добавление закончено, Freeze за один проход переносит
+// элементы в непрерывный Vector
+template <typename T>
+class ConcurrentVector {
+public:
+    ConcurrentVector() noexcept = default;
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+    ~ConcurrentVector();
+
+    // Потокобезопасны. Если конструктор элемента выбросит исключение, его позиция остаётся
+    // пустой: она учитывается в Size, но не попадает в результат Freeze
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+    T& PushBack(const T &value);
+    T& PushBack(T &&value);
+
+    // число позиций, зарезервированных под элементы
+    size_t Size() const noexcept;
+    // элемент с индексом index создан и доступен для чтения
+    bool IsConstructed(size_t index) const noexcept;
+
+    // Доступ к созданным элементам; безопасен одновременно с добавлением новых
+    const T& operator[](size_t index) const noexcept;
+    T& operator[](size_t index) noexcept;
+
+    // Переносит созданные элементы в непрерывный вектор в порядке индексов и очищает контейнер.
+    // Не должен вызываться одновременно с добавлением элементов
+    Vector<T> Freeze();
+
+private:
+    // ёмкость первого сегмента; сегмент k вмещает FIRST_SEGMENT_SIZE << k элементов
+    static constexpr size_t FIRST_SEGMENT_BITS = 5;
+    static constexpr size_t FIRST_SEGMENT_SIZE = size_t{1} << FIRST_SEGMENT_BITS;
+    static constexpr size_t MAX_SEGMENTS = std::numeric_limits<size_t>::digits - FIRST_SEGMENT_BITS;
+
+    struct Segment {
+        explicit Segment(size_t capacity);
+
+        RawMemory<T> data;
+        std::unique_ptr<std::atomic<bool>[]> constructed;
+    };
+
+    std::atomic<Segment*> segments_[MAX_SEGMENTS] = {};
+    std::atomic<size_t> size_{0};
+
+    // номер сегмента и позиция в нём для элемента с индексом index
+    static std::pair<size_t, size_t> Locate(size_t index) noexcept;
+    static size_t SegmentCapacity(size_t segment) noexcept;
+
+    // сегмент с номером segment; выделяется первым обратившимся к нему потоком
+    Segment& GetSegment(size_t segment);
+
+    // удаляет созданные элементы и освобождает сегменты
+    void Destroy() noexcept;
+
+}; // class ConcurrentVector
+
+template <typename T>
+ConcurrentVector<T>::Segment::Segment(size_t capacity)
+    : data(capacity)
+    , constructed(std::make_unique<std::atomic<bool>[]>(capacity))  //
+{
+}
+
+template <typename T>
+ConcurrentVector<T>::~ConcurrentVector() {
+    Destroy();
+}
+
+template <typename T>
+template <typename... Args>
+T& ConcurrentVector<T>::EmplaceBack(Args&&... args) {
+    const size_t index = size_.fetch_add(1, std::memory_order_relaxed);
+    const auto [segment_index, offset] = Locate(index);
+    Segment &segment = GetSegment(segment_index);
+    T *elem = new (segment.data + offset) T(std::forward<Args>(args)...);
+    segment.constructed[offset].store(true, std::memory_order_release);
+    return *elem;
+}
+
+template <typename T>
+T& ConcurrentVector<T>::PushBack(const T &value) {
+    return EmplaceBack(value);
+}
+
+template <typename T>
+T& ConcurrentVector<T>::PushBack(T &&value) {
+    return EmplaceBack(std::move(value));
+}
+
+template <typename T>
+size_t ConcurrentVector<T>::Size() const noexcept {
+    return size_.load(std::memory_order_acquire);
+}
+
+template <typename T>
+bool ConcurrentVector<T>::IsConstructed(size_t index) const noexcept {
+    if (index >= Size()) {
+        return false;
+    }
+    const auto [segment_index, offset] = Locate(index);
+    const Segment *segment = segments_[segment_index].load(std::memory_order_acquire);
+    return segment != nullptr && segment->constructed[offset].load(std::memory_order_acquire);
+}
+
+template <typename T>
+const T& ConcurrentVector<T>::operator[](size_t index) const noexcept {
+    return const_cast<ConcurrentVector&>(*this)[index];
+}
+
+template <typename T>
+T& ConcurrentVector<T>::operator[](size_t index) noexcept {
+    assert(IsConstructed(index));
+    const auto [segment_index, offset] = Locate(index);
+    return *(segments_[segment_index].load(std::memory_order_acquire)->data + offset);
+}
+
+template <typename T>
+Vector<T> ConcurrentVector<T>::Freeze() {
+    const size_t size = Size();
+    Vector<T> result;
+    result.Reserve(size);
+    size_t first = 0;
+    for (size_t segment_index = 0; first < size; ++segment_index) {
+        const size_t count = std::min(SegmentCapacity(segment_index), size - first);
+        // сегмента нет, если его выделение завершилось исключением
+        if (Segment *segment = segments_[segment_index].load(std::memory_order_acquire)) {
+            for (size_t offset = 0; offset < count; ++offset) {
+                if (segment->constructed[offset].load(std::memory_order_acquire)) {
+                    result.EmplaceBack(std::move(segment->data[offset]));
+                }
+            }
+        }
+        first += count;
+    }
+    Destroy();
+    return result;
+}
+
+template <typename T>
+std::pair<size_t, size_t> ConcurrentVector<T>::Locate(size_t index) noexcept {
+    // индексы сегмента k начинаются с FIRST_SEGMENT_SIZE * (2^k - 1), поэтому номер сегмента
+    // определяется старшим битом смещённого индекса
+    const size_t biased = index + FIRST_SEGMENT_SIZE;
+#if defined(__GNUC__)
+    const size_t high_bit = static_cast<size_t>(std::numeric_limits<unsigned long long>::digits - 1
+                                                - __builtin_clzll(biased));
+#else
+    size_t high_bit = 0;
+    while ((biased >> high_bit) > 1) {
+        ++high_bit;
+    }
+#endif
+    return {high_bit - FIRST_SEGMENT_BITS, biased - (size_t{1} << high_bit)};
+}
+
+template <typename T>
+size_t ConcurrentVector<T>::SegmentCapacity(size_t segment) noexcept {
+    return FIRST_SEGMENT_SIZE << segment;
+}
+
+template <typename T>
+typename ConcurrentVector<T>::Segment& ConcurrentVector<T>::GetSegment(size_t segment_index) {
+    Segment *segment = segments_[segment_index].load(std::memory_order_acquire);
+    if (segment == nullptr) {
+        // сегмент может одновременно выделить несколько потоков: сохраняется первый,
+        // остальные освобождают свои копии
+        auto fresh = std::make_unique<Segment>(SegmentCapacity(segment_index));
+        if (segments_[segment_index].compare_exchange_strong(segment, fresh.get(), std::memory_order_acq_rel,
+                                                             std::memory_order_acquire)) {
+            segment = fresh.release();
+        }
+    }
+    return *segment;
+}
+
+template <typename T>
+void ConcurrentVector<T>::Destroy() noexcept {
+    for (size_t segment_index = 0; segment_index < MAX_SEGMENTS; ++segment_index) {
+        std::unique_ptr<Segment> segment(segments_[segment_index].exchange(nullptr, std::memory_order_acq_rel));
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t offset = 0; segment && offset < segment->data.Capacity(); ++offset) {
+                if (segment->constructed[offset].load(std::memory_order_relaxed)) {
+                    std::destroy_at(segment->data + offset);
+                }
+            }
+        }
+    }
+    size_.store(0, std::memory_order_relaxed);
+}
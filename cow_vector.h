@@ -0,0 +1,343 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+
+// ---------------------------------- COW VECTOR ----------------------------------------
+
+// Вектор с копированием при записи: копии разделяют один блок с элементами и счётчиком ссылок,
+// поэтому копирование выполняется за O(1) без выделения памяти. Блок клонируется при первом
+// изменяющем вызове (EmplaceBack, неконстантные operator[] и begin/end, Erase, ...) у копии,
+// которая разделяет его с другими. Неконстантные operator[] и begin/end выдают ссылки, через
+// которые элементы можно изменить позже, поэтому после них блок помечается неразделяемым
+// и копии клонируют элементы сразу, пока Clear не удалит элементы. Ссылки и итераторы, возвращаемые
+// EmplaceBack, Emplace, Insert и Erase, действительны только до следующего копирования вектора.
+// Разные объекты CowVector, разделяющие блок, можно использовать из разных потоков
+// одновременно; один объект без синхронизации - нельзя
+template <typename T>
+class CowVector {
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    // Неконстантные версии отделяют вектор от разделяемого блока и запрещают его разделение
+    iterator begin();
+    iterator end();
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    CowVector() noexcept = default;
+    explicit CowVector(size_t size);
+    CowVector(std::initializer_list<T> init);
+    // забирает элементы items без копирования
+    explicit CowVector(Vector<T> &&items);
+    // клонирует элементы, если блок other помечен неразделяемым
+    CowVector(const CowVector &other);
+    CowVector(CowVector &&other) noexcept;
+
+    CowVector& operator=(const CowVector &rhs);
+    CowVector& operator=(CowVector &&rhs) noexcept;
+
+    ~CowVector();
+
+    void Swap(CowVector &other) noexcept;
+
+    size_t Size() const noexcept;
+    size_t Capacity() const noexcept;
+    // блок с элементами разделяется с другими копиями
+    bool IsShared() const noexcept;
+    // элементы для чтения без отделения от блока
+    const Vector<T>& View() const noexcept;
+
+    void Reserve(size_t new_capacity);
+    void Resize(size_t new_size);
+    // у разделяемого вектора только отпускает блок, не копируя элементы;
+    // собственный блок снова разрешает разделение
+    void Clear() noexcept;
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+    T& PushBack(const T &value);
+    T& PushBack(T &&value);
+    void PopBack();
+
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args);
+    iterator Insert(const_iterator pos, const T &value);
+    iterator Insert(const_iterator pos, T &&value);
+    iterator Erase(const_iterator pos);
+    iterator Erase(const_iterator first, const_iterator last);
+
+    const T& operator[](size_t index) const noexcept;
+    // отделяет вектор от разделяемого блока и запрещает его разделение
+    T& operator[](size_t index);
+
+private:
+    struct Block {
+        std::atomic<size_t> refs{1};
+        Vector<T> items;
+        // false, если владелец выдал изменяемую ссылку на элемент. Такой блок принадлежит
+        // одному объекту, поэтому флаг читается и изменяется без синхронизации
+        bool shareable = true;
+    };
+
+    Block *block_ = nullptr;
+
+    // Делает блок вектора собственным (клонируя разделяемый блок с ёмкостью не меньше capacity)
+    // и возвращает вектор с прежним блоком: он должен жить до конца изменения, так как аргументы
+    // вызова могут ссылаться на элементы прежнего блока
+    CowVector Detach(size_t capacity = 0);
+    // отделяет вектор и запрещает разделение его блока
+    Vector<T>& Leak();
+    Vector<T>& Items() noexcept;
+    void Release() noexcept;
+
+}; // class CowVector
+
+template <typename T>
+typename CowVector<T>::iterator CowVector<T>::begin() {
+    return Leak().begin();
+}
+
+template <typename T>
+typename CowVector<T>::iterator CowVector<T>::end() {
+    return Leak().end();
+}
+
+template <typename T>
+typename CowVector<T>::const_iterator CowVector<T>::begin() const noexcept {
+    return View().begin();
+}
+
+template <typename T>
+typename CowVector<T>::const_iterator CowVector<T>::end() const noexcept {
+    return View().end();
+}
+
+template <typename T>
+typename CowVector<T>::const_iterator CowVector<T>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename T>
+typename CowVector<T>::const_iterator CowVector<T>::cend() const noexcept {
+    return end();
+}
+
+template <typename T>
+CowVector<T>::CowVector(size_t size)
+    : CowVector(Vector<T>(size))  //
+{
+}
+
+template <typename T>
+CowVector<T>::CowVector(std::initializer_list<T> init)
+    : CowVector(Vector<T>(init))  //
+{
+}
+
+template <typename T>
+CowVector<T>::CowVector(Vector<T> &&items)
+    : block_(new Block{})  //
+{
+    block_->items = std::move(items);
+}
+
+template <typename T>
+CowVector<T>::CowVector(const CowVector &other) {
+    if (other.block_ == nullptr) {
+        return;
+    }
+    if (other.block_->shareable) {
+        other.block_->refs.fetch_add(1, std::memory_order_relaxed);
+        block_ = other.block_;
+    } else {
+        // через выданные ссылки other может изменить элементы своего блока и после копирования
+        auto fresh = std::make_unique<Block>();
+        fresh->items.Reserve(other.block_->items.Size());
+        fresh->items.Append(other.block_->items);
+        block_ = fresh.release();
+    }
+}
+
+template <typename T>
+CowVector<T>::CowVector(CowVector &&other) noexcept
+    : block_(std::exchange(other.block_, nullptr))  //
+{
+}
+
+template <typename T>
+CowVector<T>& CowVector<T>::operator=(const CowVector &rhs) {
+    CowVector rhs_copy(rhs);
+    Swap(rhs_copy);
+    return *this;
+}
+
+template <typename T>
+CowVector<T>& CowVector<T>::operator=(CowVector &&rhs) noexcept {
+    if (this != &rhs) {
+        Release();
+        block_ = std::exchange(rhs.block_, nullptr);
+    }
+    return *this;
+}
+
+template <typename T>
+CowVector<T>::~CowVector() {
+    Release();
+}
+
+template <typename T>
+void CowVector<T>::Swap(CowVector &other) noexcept {
+    std::swap(block_, other.block_);
+}
+
+template <typename T>
+size_t CowVector<T>::Size() const noexcept {
+    return View().Size();
+}
+
+template <typename T>
+size_t CowVector<T>::Capacity() const noexcept {
+    return View().Capacity();
+}
+
+template <typename T>
+bool CowVector<T>::IsShared() const noexcept {
+    // acquire: изменения блока в текущем потоке не должны опережать чтение элементов
+    // другими владельцами до того, как они отпустили блок
+    return block_ != nullptr && block_->refs.load(std::memory_order_acquire) > 1;
+}
+
+template <typename T>
+const Vector<T>& CowVector<T>::View() const noexcept {
+    static const Vector<T> empty;
+    return block_ != nullptr ? block_->items : empty;
+}
+
+template <typename T>
+void CowVector<T>::Reserve(size_t new_capacity) {
+    const CowVector previous = Detach(new_capacity);
+    Items().Reserve(new_capacity);
+}
+
+template <typename T>
+void CowVector<T>::Resize(size_t new_size) {
+    const CowVector previous = Detach(new_size);
+    Items().Resize(new_size);
+}
+
+template <typename T>
+void CowVector<T>::Clear() noexcept {
+    if (IsShared()) {
+        Release();
+    } else if (block_ != nullptr) {
+        block_->items.Clear();
+        block_->shareable = true;
+    }
+}
+
+template <typename T>
+template <typename... Args>
+T& CowVector<T>::EmplaceBack(Args&&... args) {
+    const CowVector previous = Detach(Size() + 1);
+    return Items().EmplaceBack(std::forward<Args>(args)...);
+}
+
+template <typename T>
+T& CowVector<T>::PushBack(const T &value) {
+    return EmplaceBack(value);
+}
+
+template <typename T>
+T& CowVector<T>::PushBack(T &&value) {
+    return EmplaceBack(std::move(value));
+}
+
+template <typename T>
+void CowVector<T>::PopBack() {
+    const CowVector previous = Detach();
+    Items().PopBack();
+}
+
+template <typename T>
+template <typename... Args>
+typename CowVector<T>::iterator CowVector<T>::Emplace(const_iterator pos, Args&&... args) {
+    // после клонирования pos указывает в прежний блок, поэтому позиция пересчитывается по индексу
+    const auto index = pos - cbegin();
+    const CowVector previous = Detach(Size() + 1);
+    Vector<T> &items = Items();
+    return items.Emplace(items.cbegin() + index, std::forward<Args>(args)...);
+}
+
+template <typename T>
+typename CowVector<T>::iterator CowVector<T>::Insert(const_iterator pos, const T &value) {
+    return Emplace(pos, value);
+}
+
+template <typename T>
+typename CowVector<T>::iterator CowVector<T>::Insert(const_iterator pos, T &&value) {
+    return Emplace(pos, std::move(value));
+}
+
+template <typename T>
+typename CowVector<T>::iterator CowVector<T>::Erase(const_iterator pos) {
+    return Erase(pos, pos + 1);
+}
+
+template <typename T>
+typename CowVector<T>::iterator CowVector<T>::Erase(const_iterator first, const_iterator last) {
+    const auto index = first - cbegin();
+    const auto count = last - first;
+    const CowVector previous = Detach();
+    Vector<T> &items = Items();
+    return items.Erase(items.cbegin() + index, items.cbegin() + index + count);
+}
+
+template <typename T>
+const T& CowVector<T>::operator[](size_t index) const noexcept {
+    return View()[index];
+}
+
+template <typename T>
+T& CowVector<T>::operator[](size_t index) {
+    return Leak()[index];
+}
+
+template <typename T>
+CowVector<T> CowVector<T>::Detach(size_t capacity) {
+    CowVector previous;
+    if (block_ == nullptr) {
+        block_ = new Block{};
+    } else if (IsShared()) {
+        auto fresh = std::make_unique<Block>();
+        fresh->items.Reserve(std::max(capacity, block_->items.Size()));
+        fresh->items.Append(block_->items);
+        previous.block_ = std::exchange(block_, fresh.release());
+    }
+    return previous;
+}
+
+template <typename T>
+Vector<T>& CowVector<T>::Leak() {
+    const CowVector previous = Detach();
+    block_->shareable = false;
+    return Items();
+}
+
+template <typename T>
+Vector<T>& CowVector<T>::Items() noexcept {
+    assert(block_ != nullptr && !IsShared());
+    return block_->items;
+}
+
+template <typename T>
+void CowVector<T>::Release() noexcept {
+    if (block_ != nullptr && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete block_;
+    }
+    block_ = nullptr;
+}
@@ -0,0 +1,260 @@
+#pragma once
+#include "flat_set.h"
+
+#include <stdexcept>
+
+// ------------------------------------- FLAT MAP ---------------------------------------
+
+// Отображение с ключами, хранящимися по возрастанию в одном Vector<K>, и значениями в отдельном
+// Vector<V> в том же порядке. Поиск просматривает только плотный массив ключей,
+// а значения загружаются в кэш лишь для найденного ключа
+template <typename K, typename V, typename Compare = std::less<K>>
+class FlatMap {
+public:
+    using key_type = K;
+    using mapped_type = V;
+
+    FlatMap() noexcept = default;
+    // Сортирует пары по ключу и удаляет повторы за один проход; из повторов остаётся первая пара
+    explicit FlatMap(Vector<std::pair<K, V>> items, Compare comp = Compare());
+    FlatMap(std::initializer_list<std::pair<K, V>> items, Compare comp = Compare());
+
+    size_t Size() const noexcept;
+    void Reserve(size_t new_capacity);
+    void Clear() noexcept;
+    // отсортированные ключи и значения в том же порядке
+    const Vector<K>& Keys() const noexcept;
+    const Vector<V>& Values() const noexcept;
+    Span<V> Values() noexcept;
+
+    bool Contains(const K &key) const;
+    // значение ключа key или nullptr
+    const V* Find(const K &key) const;
+    V* Find(const K &key);
+    // значение ключа key; выбрасывает std::out_of_range, если ключа нет
+    const V& At(const K &key) const;
+    V& At(const K &key);
+    // значение ключа key, созданное по умолчанию при отсутствии ключа
+    V& operator[](const K &key);
+
+    // Создаёт значение из args, если ключа ещё нет. Возвращает значение ключа и признак вставки
+    template <typename... Args>
+    std::pair<V*, bool> TryEmplace(const K &key, Args&&... args);
+    std::pair<V*, bool> Insert(const K &key, const V &value);
+    std::pair<V*, bool> Insert(const K &key, V &&value);
+    // Добавляет пары отсортированного по ключу диапазона range слиянием за один проход по обоим
+    // наборам, без поэлементной вставки. Из повторов остаются существующие пары. При исключении
+    // копирования отображение не изменяется (сравнение не должно выбрасывать исключений)
+    template <typename Range>
+    void InsertSorted(const Range &range);
+    // удаляет ключ и возвращает число удалённых пар (0 или 1)
+    size_t Erase(const K &key);
+
+private:
+    Vector<K> keys_;
+    Vector<V> values_;
+    Compare comp_;
+
+    // индекс первого ключа, не меньшего key, и признак равенства ключа key
+    std::pair<size_t, bool> Locate(const K &key) const;
+
+}; // class FlatMap
+
+template <typename K, typename V, typename Compare>
+FlatMap<K, V, Compare>::FlatMap(Vector<std::pair<K, V>> items, Compare comp)
+    : comp_(std::move(comp))  //
+{
+    std::stable_sort(items.begin(), items.end(), [this](const auto &lhs, const auto &rhs) {
+        return comp_(lhs.first, rhs.first);
+    });
+    keys_.Reserve(items.Size());
+    values_.Reserve(items.Size());
+    for (auto &[key, value] : items) {
+        if (keys_.Size() == 0 || comp_(keys_[keys_.Size() - 1], key)) {
+            keys_.EmplaceBack(std::move(key));
+            values_.EmplaceBack(std::move(value));
+        }
+    }
+}
+
+template <typename K, typename V, typename Compare>
+FlatMap<K, V, Compare>::FlatMap(std::initializer_list<std::pair<K, V>> items, Compare comp)
+    : FlatMap(Vector<std::pair<K, V>>(items), std::move(comp))  //
+{
+}
+
+template <typename K, typename V, typename Compare>
+size_t FlatMap<K, V, Compare>::Size() const noexcept {
+    return keys_.Size();
+}
+
+template <typename K, typename V, typename Compare>
+void FlatMap<K, V, Compare>::Reserve(size_t new_capacity) {
+    keys_.Reserve(new_capacity);
+    values_.Reserve(new_capacity);
+}
+
+template <typename K, typename V, typename Compare>
+void FlatMap<K, V, Compare>::Clear() noexcept {
+    keys_.Clear();
+    values_.Clear();
+}
+
+template <typename K, typename V, typename Compare>
+const Vector<K>& FlatMap<K, V, Compare>::Keys() const noexcept {
+    return keys_;
+}
+
+template <typename K, typename V, typename Compare>
+const Vector<V>& FlatMap<K, V, Compare>::Values() const noexcept {
+    return values_;
+}
+
+template <typename K, typename V, typename Compare>
+Span<V> FlatMap<K, V, Compare>::Values() noexcept {
+    return values_.AsSpan();
+}
+
+template <typename K, typename V, typename Compare>
+bool FlatMap<K, V, Compare>::Contains(const K &key) const {
+    return Locate(key).second;
+}
+
+template <typename K, typename V, typename Compare>
+const V* FlatMap<K, V, Compare>::Find(const K &key) const {
+    return const_cast<FlatMap&>(*this).Find(key);
+}
+
+template <typename K, typename V, typename Compare>
+V* FlatMap<K, V, Compare>::Find(const K &key) {
+    const auto [index, found] = Locate(key);
+    return found ? &values_[index] : nullptr;
+}
+
+template <typename K, typename V, typename Compare>
+const V& FlatMap<K, V, Compare>::At(const K &key) const {
+    return const_cast<FlatMap&>(*this).At(key);
+}
+
+template <typename K, typename V, typename Compare>
+V& FlatMap<K, V, Compare>::At(const K &key) {
+    V *value = Find(key);
+    if (value == nullptr) {
+        throw std::out_of_range("FlatMap key not found");
+    }
+    return *value;
+}
+
+template <typename K, typename V, typename Compare>
+V& FlatMap<K, V, Compare>::operator[](const K &key) {
+    return *TryEmplace(key).first;
+}
+
+template <typename K, typename V, typename Compare>
+template <typename... Args>
+std::pair<V*, bool> FlatMap<K, V, Compare>::TryEmplace(const K &key, Args&&... args) {
+    const auto [index, found] = Locate(key);
+    if (found) {
+        return {&values_[index], false};
+    }
+    // значение вставляется первым: если вставка ключа не удастся, оно удаляется
+    // без исключений, и ключи со значениями остаются согласованными
+    auto value = values_.Emplace(values_.cbegin() + index, std::forward<Args>(args)...);
+    try {
+        keys_.Insert(keys_.cbegin() + index, key);
+    } catch (...) {
+        values_.Erase(value);
+        throw;
+    }
+    return {&values_[index], true};
+}
+
+template <typename K, typename V, typename Compare>
+std::pair<V*, bool> FlatMap<K, V, Compare>::Insert(const K &key, const V &value) {
+    return TryEmplace(key, value);
+}
+
+template <typename K, typename V, typename Compare>
+std::pair<V*, bool> FlatMap<K, V, Compare>::Insert(const K &key, V &&value) {
+    return TryEmplace(key, std::move(value));
+}
+
+template <typename K, typename V, typename Compare>
+template <typename Range>
+void FlatMap<K, V, Compare>::InsertSorted(const Range &range) {
+    auto first = std::begin(range);
+    const auto last = std::end(range);
+    assert(std::is_sorted(first, last, [this](const auto &lhs, const auto &rhs) {
+        return comp_(lhs.first, rhs.first);
+    }));
+    if (first == last) {
+        return;
+    }
+    // пары диапазона копируются до изменения keys_ и values_, чтобы исключение копирования
+    // не оставило в отображении перемещённые ключи и значения
+    const size_t count = static_cast<size_t>(std::distance(first, last));
+    Vector<K> incoming_keys;
+    Vector<V> incoming_values;
+    incoming_keys.Reserve(count);
+    incoming_values.Reserve(count);
+    for (; first != last; ++first) {
+        incoming_keys.EmplaceBack(first->first);
+        incoming_values.EmplaceBack(first->second);
+    }
+    Vector<K> keys;
+    Vector<V> values;
+    keys.Reserve(keys_.Size() + count);
+    values.Reserve(keys_.Size() + count);
+    auto push = [&](auto &&key, auto &&value) {
+        // повторы идут подряд, поэтому достаточно сравнить ключ с последним добавленным
+        if (keys.Size() == 0 || comp_(keys[keys.Size() - 1], key)) {
+            keys.EmplaceBack(std::forward<decltype(key)>(key));
+            values.EmplaceBack(std::forward<decltype(value)>(value));
+        }
+    };
+    // собственные пары перемещаются, только если перемещение ключа и значения не выбрасывает исключений
+    constexpr bool MOVE_OWN = std::is_nothrow_move_constructible_v<K> && std::is_nothrow_move_constructible_v<V>;
+    auto push_own = [&](size_t index) {
+        if constexpr (MOVE_OWN) {
+            push(std::move(keys_[index]), std::move(values_[index]));
+        } else {
+            push(std::as_const(keys_[index]), std::as_const(values_[index]));
+        }
+    };
+    size_t current = 0;
+    size_t next = 0;
+    while (current < keys_.Size() && next < count) {
+        if (comp_(incoming_keys[next], keys_[current])) {
+            push(std::move(incoming_keys[next]), std::move(incoming_values[next]));
+            ++next;
+        } else {
+            push_own(current);
+            ++current;
+        }
+    }
+    for (; current < keys_.Size(); ++current) {
+        push_own(current);
+    }
+    for (; next < count; ++next) {
+        push(std::move(incoming_keys[next]), std::move(incoming_values[next]));
+    }
+    keys_ = std::move(keys);
+    values_ = std::move(values);
+}
+
+template <typename K, typename V, typename Compare>
+size_t FlatMap<K, V, Compare>::Erase(const K &key) {
+    const auto [index, found] = Locate(key);
+    if (!found) {
+        return 0;
+    }
+    keys_.Erase(keys_.cbegin() + index);
+    values_.Erase(values_.cbegin() + index);
+    return 1;
+}
+
+template <typename K, typename V, typename Compare>
+std::pair<size_t, bool> FlatMap<K, V, Compare>::Locate(const K &key) const {
+    const size_t index = BranchlessLowerBound(keys_.begin(), keys_.Size(), key, comp_);
+    return {index, index < keys_.Size() && !comp_(key, keys_[index])};
+}
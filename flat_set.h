@@ -0,0 +1,233 @@
+#pragma once
+#include "vector.h"
+
+// ------------------------------------ LOWER BOUND -------------------------------------
+
+// Двоичный поиск первого элемента отсортированного массива, не меньшего key. Шаг поиска не содержит
+// условных переходов (компилятор использует cmov), поэтому не страдает от ошибок предсказания
+// ветвлений, а обе возможные позиции следующего шага заранее запрашиваются в кэш
+template <typename K, typename Compare = std::less<K>>
+size_t BranchlessLowerBound(const K *data, size_t size, const K &key, Compare comp = Compare()) {
+    if (size == 0) {
+        return 0;
+    }
+    const K *base = data;
+    while (size > 1) {
+        const size_t half = size / 2;
+#if defined(__GNUC__)
+        __builtin_prefetch(base + half / 2);
+        __builtin_prefetch(base + half + half / 2);
+#endif
+        base = comp(base[half], key) ? base + half : base;
+        size -= half;
+    }
+    return static_cast<size_t>(base - data) + static_cast<size_t>(comp(*base, key));
+}
+
+// ------------------------------------- FLAT SET ---------------------------------------
+
+// Множество уникальных ключей, хранящихся по возрастанию в непрерывном Vector<K>. Поиск - двоичный
+// по непрерывной памяти, вставка и удаление одного ключа сдвигают хвост, поэтому большие наборы
+// ключей следует добавлять через InsertSorted или конструктор
+template <typename K, typename Compare = std::less<K>>
+class FlatSet {
+public:
+    using value_type = K;
+    using iterator = const K*;
+    using const_iterator = const K*;
+
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+
+    FlatSet() noexcept = default;
+    // Сортирует ключи и удаляет повторы за один проход
+    explicit FlatSet(Vector<K> keys, Compare comp = Compare());
+    FlatSet(std::initializer_list<K> keys, Compare comp = Compare());
+
+    size_t Size() const noexcept;
+    void Reserve(size_t new_capacity);
+    void Clear() noexcept;
+    // отсортированные ключи
+    const Vector<K>& Keys() const noexcept;
+
+    bool Contains(const K &key) const;
+    // первый ключ, не меньший key
+    const_iterator LowerBound(const K &key) const;
+    // ключ, равный key, или end()
+    const_iterator Find(const K &key) const;
+
+    // Вставляет ключ, если его ещё нет. Возвращает позицию ключа и признак вставки
+    std::pair<const_iterator, bool> Insert(const K &key);
+    std::pair<const_iterator, bool> Insert(K &&key);
+    // Добавляет ключи отсортированного диапазона range слиянием за один проход по обоим
+    // наборам ключей, без поэлементной вставки. Повторы пропускаются. При исключении копирования
+    // ключей множество не изменяется (сравнение не должно выбрасывать исключений)
+    template <typename Range>
+    void InsertSorted(const Range &range);
+    // удаляет ключ и возвращает число удалённых ключей (0 или 1)
+    size_t Erase(const K &key);
+    const_iterator Erase(const_iterator pos);
+
+private:
+    Vector<K> keys_;
+    Compare comp_;
+
+    bool Equal(const K &lhs, const K &rhs) const;
+    template <typename Key>
+    std::pair<const_iterator, bool> InsertKey(Key &&key);
+
+}; // class FlatSet
+
+template <typename K, typename Compare>
+typename FlatSet<K, Compare>::const_iterator FlatSet<K, Compare>::begin() const noexcept {
+    return keys_.begin();
+}
+
+template <typename K, typename Compare>
+typename FlatSet<K, Compare>::const_iterator FlatSet<K, Compare>::end() const noexcept {
+    return keys_.end();
+}
+
+template <typename K, typename Compare>
+FlatSet<K, Compare>::FlatSet(Vector<K> keys, Compare comp)
+    : keys_(std::move(keys))
+    , comp_(std::move(comp))  //
+{
+    std::stable_sort(keys_.begin(), keys_.end(), comp_);
+    auto last = std::unique(keys_.begin(), keys_.end(), [this](const K &lhs, const K &rhs) {
+        return Equal(lhs, rhs);
+    });
+    keys_.Erase(last, keys_.end());
+}
+
+template <typename K, typename Compare>
+FlatSet<K, Compare>::FlatSet(std::initializer_list<K> keys, Compare comp)
+    : FlatSet(Vector<K>(keys), std::move(comp))  //
+{
+}
+
+template <typename K, typename Compare>
+size_t FlatSet<K, Compare>::Size() const noexcept {
+    return keys_.Size();
+}
+
+template <typename K, typename Compare>
+void FlatSet<K, Compare>::Reserve(size_t new_capacity) {
+    keys_.Reserve(new_capacity);
+}
+
+template <typename K, typename Compare>
+void FlatSet<K, Compare>::Clear() noexcept {
+    keys_.Clear();
+}
+
+template <typename K, typename Compare>
+const Vector<K>& FlatSet<K, Compare>::Keys() const noexcept {
+    return keys_;
+}
+
+template <typename K, typename Compare>
+bool FlatSet<K, Compare>::Contains(const K &key) const {
+    return Find(key) != end();
+}
+
+template <typename K, typename Compare>
+typename FlatSet<K, Compare>::const_iterator FlatSet<K, Compare>::LowerBound(const K &key) const {
+    return keys_.begin() + BranchlessLowerBound(keys_.begin(), keys_.Size(), key, comp_);
+}
+
+template <typename K, typename Compare>
+typename FlatSet<K, Compare>::const_iterator FlatSet<K, Compare>::Find(const K &key) const {
+    const auto it = LowerBound(key);
+    return it != end() && !comp_(key, *it) ? it : end();
+}
+
+template <typename K, typename Compare>
+std::pair<typename FlatSet<K, Compare>::const_iterator, bool> FlatSet<K, Compare>::Insert(const K &key) {
+    return InsertKey(key);
+}
+
+template <typename K, typename Compare>
+std::pair<typename FlatSet<K, Compare>::const_iterator, bool> FlatSet<K, Compare>::Insert(K &&key) {
+    return InsertKey(std::move(key));
+}
+
+template <typename K, typename Compare>
+template <typename Range>
+void FlatSet<K, Compare>::InsertSorted(const Range &range) {
+    auto first = std::begin(range);
+    const auto last = std::end(range);
+    assert(std::is_sorted(first, last, comp_));
+    if (first == last) {
+        return;
+    }
+    // ключи диапазона копируются до изменения keys_, чтобы исключение копирования не оставило
+    // в множестве перемещённые ключи
+    Vector<K> incoming;
+    incoming.Reserve(static_cast<size_t>(std::distance(first, last)));
+    for (; first != last; ++first) {
+        incoming.EmplaceBack(*first);
+    }
+    Vector<K> merged;
+    merged.Reserve(keys_.Size() + incoming.Size());
+    auto push = [&](auto &&key) {
+        // повторы идут подряд, поэтому достаточно сравнить ключ с последним добавленным
+        if (merged.Size() == 0 || comp_(merged[merged.Size() - 1], key)) {
+            merged.EmplaceBack(std::forward<decltype(key)>(key));
+        }
+    };
+    // ключи множества перемещаются, только если перемещение не выбрасывает исключений
+    auto own = [](K &key) -> decltype(auto) {
+        if constexpr (std::is_nothrow_move_constructible_v<K>) {
+            return std::move(key);
+        } else {
+            return static_cast<const K&>(key);
+        }
+    };
+    K *current = keys_.begin();
+    K *next = incoming.begin();
+    while (current != keys_.end() && next != incoming.end()) {
+        if (comp_(*next, *current)) {
+            push(std::move(*next++));
+        } else {
+            push(own(*current++));
+        }
+    }
+    for (; current != keys_.end(); ++current) {
+        push(own(*current));
+    }
+    for (; next != incoming.end(); ++next) {
+        push(std::move(*next));
+    }
+    keys_ = std::move(merged);
+}
+
+template <typename K, typename Compare>
+size_t FlatSet<K, Compare>::Erase(const K &key) {
+    const auto it = Find(key);
+    if (it == end()) {
+        return 0;
+    }
+    Erase(it);
+    return 1;
+}
+
+template <typename K, typename Compare>
+typename FlatSet<K, Compare>::const_iterator FlatSet<K, Compare>::Erase(const_iterator pos) {
+    return keys_.Erase(pos);
+}
+
+template <typename K, typename Compare>
+bool FlatSet<K, Compare>::Equal(const K &lhs, const K &rhs) const {
+    return !comp_(lhs, rhs) && !comp_(rhs, lhs);
+}
+
+template <typename K, typename Compare>
+template <typename Key>
+std::pair<typename FlatSet<K, Compare>::const_iterator, bool> FlatSet<K, Compare>::InsertKey(Key &&key) {
+    const auto it = LowerBound(key);
+    if (it != end() && !comp_(key, *it)) {
+        return {it, false};
+    }
+    return {keys_.Insert(it, std::forward<Key>(key)), true};
+}
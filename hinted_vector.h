@@ -0,0 +1,351 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// ------------------------------- RESERVE HINT SITE ------------------------------------
+
+// Счётчики места создания векторов
+struct ReserveHintStats {
+    // векторы, размер которых учтён при разрушении
+    size_t samples = 0;
+    // векторы, выросшие больше ёмкости, зарезервированной при создании
+    size_t overflows = 0;
+    // текущая подсказка для Reserve
+    size_t hint = 0;
+};
+
+/* Гистограмма итоговых размеров векторов, создаваемых в одном месте программы. Размеры
+   делятся на интервалы: по четыре на каждую степень двойки, поэтому подсказка превышает
+   наблюдаемый размер не более чем на четверть. Подсказка - верхняя граница интервала, в который
+   попадает заданный перцентиль размеров. Она пересчитывается после первых MIN_SAMPLES
+   векторов и далее каждые UPDATE_PERIOD векторов, а при большом числе наблюдений счётчики
+   делятся пополам, чтобы подсказка следовала за изменением нагрузки. Счётчики атомарные,
+   и место может использоваться из нескольких потоков; пересчёт, идущий одновременно
+   с записью, даёт приблизительный результат */
+class ReserveHintSite {
+public:
+    static constexpr size_t NUM_BUCKETS = 256;
+    static constexpr size_t MIN_SAMPLES = 16;
+    static constexpr size_t UPDATE_PERIOD = 64;
+    // суммарный вес гистограммы, после которого счётчики делятся пополам
+    static constexpr uint32_t MAX_WEIGHT = uint32_t{1} << 16;
+
+    // percentile - доля векторов в процентах, которым должно хватить подсказки
+    explicit ReserveHintSite(unsigned percentile = 90) noexcept;
+
+    ReserveHintSite(const ReserveHintSite&) = delete;
+    ReserveHintSite& operator=(const ReserveHintSite&) = delete;
+
+    // ёмкость для Reserve при создании вектора; 0, пока наблюдений недостаточно
+    size_t Hint() const noexcept;
+    // учитывает итоговый размер вектора, для которого при создании была зарезервирована ёмкость reserved
+    void Record(size_t final_size, size_t reserved) noexcept;
+
+    ReserveHintStats Stats() const noexcept;
+    void Reset() noexcept;
+
+private:
+    unsigned percentile_;
+    std::atomic<size_t> samples_{0};
+    std::atomic<size_t> overflows_{0};
+    std::atomic<size_t> hint_{0};
+    std::atomic<uint32_t> buckets_[NUM_BUCKETS] = {};
+
+    static size_t BucketIndex(size_t size) noexcept;
+    static size_t BucketUpperBound(size_t index) noexcept;
+    void UpdateHint() noexcept;
+
+}; // class ReserveHintSite
+
+inline ReserveHintSite::ReserveHintSite(unsigned percentile) noexcept
+    : percentile_(percentile)  //
+{
+    assert(percentile > 0 && percentile <= 100);
+}
+
+inline size_t ReserveHintSite::Hint() const noexcept {
+    return hint_.load(std::memory_order_relaxed);
+}
+
+inline void ReserveHintSite::Record(size_t final_size, size_t reserved) noexcept {
+    buckets_[BucketIndex(final_size)].fetch_add(1, std::memory_order_relaxed);
+    if (final_size > reserved) {
+        overflows_.fetch_add(1, std::memory_order_relaxed);
+    }
+    // пересчёт выполняет только поток, чья запись совпала с границей периода
+    const size_t samples = samples_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (samples == MIN_SAMPLES || (samples > MIN_SAMPLES && samples % UPDATE_PERIOD == 0)) {
+        UpdateHint();
+    }
+}
+
+inline ReserveHintStats ReserveHintSite::Stats() const noexcept {
+    ReserveHintStats stats;
+    stats.samples = samples_.load(std::memory_order_relaxed);
+    stats.overflows = overflows_.load(std::memory_order_relaxed);
+    stats.hint = Hint();
+    return stats;
+}
+
+inline void ReserveHintSite::Reset() noexcept {
+    for (auto &bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    samples_.store(0, std::memory_order_relaxed);
+    overflows_.store(0, std::memory_order_relaxed);
+    hint_.store(0, std::memory_order_relaxed);
+}
+
+// Размеры меньше 8 имеют собственные интервалы. Размер с номером старшего бита k >= 2
+// попадает в один из четырёх интервалов [2^k, 2^(k+1)), выбираемый двумя следующими битами
+inline size_t ReserveHintSite::BucketIndex(size_t size) noexcept {
+    if (size < 8) {
+        return size;
+    }
+#if defined(__GNUC__)
+    const size_t high_bit = static_cast<size_t>(std::numeric_limits<unsigned long long>::digits - 1
+                                                - __builtin_clzll(size));
+#else
+    size_t high_bit = 0;
+    while ((size >> high_bit) > 1) {
+        ++high_bit;
+    }
+#endif
+    return 4 * (high_bit - 1) + ((size >> (high_bit - 2)) & 3);
+}
+
+inline size_t ReserveHintSite::BucketUpperBound(size_t index) noexcept {
+    if (index < 8) {
+        return index;
+    }
+    const size_t high_bit = index / 4 + 1;
+    const size_t lower = (4 + index % 4) << (high_bit - 2);
+    return lower + (size_t{1} << (high_bit - 2)) - 1;
+}
+
+inline void ReserveHintSite::UpdateHint() noexcept {
+    uint32_t counts[NUM_BUCKETS];
+    uint64_t total = 0;
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return;
+    }
+    if (total > MAX_WEIGHT) {
+        // вычитается половина прочитанного значения, чтобы не потерять записи других потоков
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+            buckets_[i].fetch_sub(counts[i] / 2, std::memory_order_relaxed);
+        }
+    }
+    const uint64_t target = (total * percentile_ + 99) / 100;
+    uint64_t accumulated = 0;
+    size_t index = 0;
+    for (; index + 1 < NUM_BUCKETS; ++index) {
+        accumulated += counts[index];
+        if (accumulated >= target) {
+            break;
+        }
+    }
+    hint_.store(BucketUpperBound(index), std::memory_order_relaxed);
+}
+
+// ------------------------------ RESERVE HINT REGISTRY ---------------------------------
+
+// Места создания векторов, именованные строковыми метками
+class ReserveHintRegistry {
+public:
+    static ReserveHintRegistry& Instance();
+
+    // место с меткой tag; ссылка действительна до конца работы программы
+    ReserveHintSite& Site(std::string_view tag);
+
+    // выводит счётчики всех мест в виде JSON-объекта
+    void DumpJson(std::ostream &out) const;
+    // сбрасывает гистограммы всех мест
+    void Reset();
+
+private:
+    ReserveHintRegistry() = default;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<ReserveHintSite>, std::less<>> sites_;
+};
+
+inline ReserveHintRegistry& ReserveHintRegistry::Instance() {
+    // реестр не разрушается, чтобы векторы в статических объектах могли обращаться к нему при завершении
+    static auto *instance = new ReserveHintRegistry();
+    return *instance;
+}
+
+inline ReserveHintSite& ReserveHintRegistry::Site(std::string_view tag) {
+    std::lock_guard lock(mutex_);
+    auto it = sites_.find(tag);
+    if (it == sites_.end()) {
+        it = sites_.emplace(std::string(tag), std::make_unique<ReserveHintSite>()).first;
+    }
+    return *it->second;
+}
+
+inline void ReserveHintRegistry::DumpJson(std::ostream &out) const {
+    std::lock_guard lock(mutex_);
+    out << "{";
+    bool first = true;
+    for (const auto &[tag, site] : sites_) {
+        out << (first ? "\n" : ",\n") << "  \"";
+        for (char c : tag) {
+            if (c == '"' || c == '\\') {
+                out << '\\';
+            }
+            out << c;
+        }
+        const ReserveHintStats stats = site->Stats();
+        out << "\": {"
+            << "\"samples\": " << stats.samples
+            << ", \"overflows\": " << stats.overflows
+            << ", \"hint\": " << stats.hint
+            << "}";
+        first = false;
+    }
+    out << (first ? "}" : "\n}") << "\n";
+}
+
+inline void ReserveHintRegistry::Reset() {
+    std::lock_guard lock(mutex_);
+    for (auto &[tag, site] : sites_) {
+        site->Reset();
+    }
+}
+
+#define VECTOR_HINT_STRINGIFY_IMPL(x) #x
+#define VECTOR_HINT_STRINGIFY(x) VECTOR_HINT_STRINGIFY_IMPL(x)
+
+// Место создания вектора с меткой "файл:строка". Метка ищется в реестре один раз
+// при первом выполнении выражения, далее используется сохранённая ссылка
+#define VECTOR_HINT_SITE()                                                                  \
+    ([]() -> ReserveHintSite& {                                                             \
+        static ReserveHintSite &site                                                        \
+            = ReserveHintRegistry::Instance().Site(__FILE__ ":" VECTOR_HINT_STRINGIFY(__LINE__)); \
+        return site;                                                                        \
+    }())
+
+// ---------------------------------- HINTED VECTOR -------------------------------------
+
+/* Вектор, который при создании резервирует ёмкость по подсказке места site, а при разрушении
+   сообщает месту свой итоговый размер. Так векторы, создаваемые в одном месте (например,
+   на время обработки запроса), после нескольких первых наблюдений заполняются без реаллокаций.
+   Перемещённый вектор передаёт место новому владельцу элементов и сам размер не сообщает */
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = DoublingGrowth>
+class HintedVector : public Vector<T, Alloc, Growth> {
+    using Base = Vector<T, Alloc, Growth>;
+
+public:
+    explicit HintedVector(ReserveHintSite &site, const Alloc &alloc = Alloc());
+    // место с меткой tag из ReserveHintRegistry
+    explicit HintedVector(std::string_view tag, const Alloc &alloc = Alloc());
+    HintedVector(const HintedVector &other);
+    HintedVector(HintedVector &&other) noexcept;
+
+    // копирование сохраняет место вектора
+    HintedVector& operator=(const HintedVector &rhs);
+    // перемещение учитывает размер прежних элементов и переходит к месту rhs
+    HintedVector& operator=(HintedVector &&rhs) noexcept(std::is_nothrow_move_assignable_v<Base>);
+
+    ~HintedVector();
+
+    // место вектора; nullptr у перемещённого вектора
+    ReserveHintSite* Site() const noexcept;
+    // ёмкость, зарезервированная при создании
+    size_t Reserved() const noexcept;
+
+private:
+    ReserveHintSite *site_;
+    size_t reserved_ = 0;
+
+    void RecordSize() noexcept;
+
+}; // class HintedVector
+
+template <typename T, typename Alloc, typename Growth>
+HintedVector<T, Alloc, Growth>::HintedVector(ReserveHintSite &site, const Alloc &alloc)
+    : Base(alloc)
+    , site_(&site)  //
+{
+    reserved_ = site.Hint();
+    if (reserved_ > 0) {
+        this->Reserve(reserved_);
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+HintedVector<T, Alloc, Growth>::HintedVector(std::string_view tag, const Alloc &alloc)
+    : HintedVector(ReserveHintRegistry::Instance().Site(tag), alloc)  //
+{
+}
+
+template <typename T, typename Alloc, typename Growth>
+HintedVector<T, Alloc, Growth>::HintedVector(const HintedVector &other)
+    : Base(other)
+    , site_(other.site_)
+    , reserved_(this->Capacity())  //
+{
+}
+
+template <typename T, typename Alloc, typename Growth>
+HintedVector<T, Alloc, Growth>::HintedVector(HintedVector &&other) noexcept
+    : Base(std::move(other))
+    , site_(std::exchange(other.site_, nullptr))
+    , reserved_(other.reserved_)  //
+{
+}
+
+template <typename T, typename Alloc, typename Growth>
+HintedVector<T, Alloc, Growth>& HintedVector<T, Alloc, Growth>::operator=(const HintedVector &rhs) {
+    Base::operator=(rhs);
+    return *this;
+}
+
+template <typename T, typename Alloc, typename Growth>
+HintedVector<T, Alloc, Growth>& HintedVector<T, Alloc, Growth>::operator=(HintedVector &&rhs)
+noexcept(std::is_nothrow_move_assignable_v<Base>) {
+    if (this != &rhs) {
+        // прежние элементы удаляются присваиванием, поэтому их размер учитывается заранее
+        RecordSize();
+        Base::operator=(std::move(rhs));
+        site_ = std::exchange(rhs.site_, nullptr);
+        reserved_ = rhs.reserved_;
+    }
+    return *this;
+}
+
+template <typename T, typename Alloc, typename Growth>
+HintedVector<T, Alloc, Growth>::~HintedVector() {
+    RecordSize();
+}
+
+template <typename T, typename Alloc, typename Growth>
+ReserveHintSite* HintedVector<T, Alloc, Growth>::Site() const noexcept {
+    return site_;
+}
+
+template <typename T, typename Alloc, typename Growth>
+size_t HintedVector<T, Alloc, Growth>::Reserved() const noexcept {
+    return reserved_;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void HintedVector<T, Alloc, Growth>::RecordSize() noexcept {
+    if (site_ != nullptr) {
+        site_->Record(this->Size(), reserved_);
+    }
+}
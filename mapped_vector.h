@@ -0,0 +1,572 @@
+#pragma once
+#include "vector.h"
+
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ---------------------------------- MAPPED MEMORY -------------------------------------
+
+enum class MapMode {
+    // файл отображается только для чтения и может одновременно использоваться несколькими процессами
+    READ_ONLY,
+    // файл создаётся при отсутствии, изменения записываются в файл
+    READ_WRITE,
+};
+
+// Сырая память под элементы, отображённая из файла (mmap), с интерфейсом RawMemory.
+// Длина файла равна ёмкости: Reallocate изменяет её через ftruncate и переотображает файл
+// (на Linux - mremap, без копирования данных). Close укорачивает файл до переданного числа элементов
+template <typename T>
+class MappedMemory {
+    static_assert(std::is_trivially_copyable_v<T>, "Mapped elements must be trivially copyable");
+
+public:
+    MappedMemory() noexcept = default;
+    // Открывает файл path и отображает его целиком. Длина файла должна быть кратна sizeof(T)
+    MappedMemory(const std::string &path, MapMode mode);
+
+    MappedMemory(const MappedMemory&) = delete;
+    MappedMemory(MappedMemory &&other) noexcept;
+
+    ~MappedMemory();
+
+    MappedMemory& operator=(const MappedMemory&) = delete;
+    MappedMemory& operator=(MappedMemory &&rhs) noexcept;
+
+    T* operator+(size_t offset) noexcept;
+    const T* operator+(size_t offset) const noexcept;
+
+    // изменяемый элемент; память в режиме READ_ONLY доступна только для чтения
+    T& operator[](size_t index) noexcept;
+    const T& operator[](size_t index) const noexcept;
+
+    void Swap(MappedMemory &other) noexcept;
+    const T* GetAddress() const noexcept;
+    T* GetAddress() noexcept;
+    size_t Capacity() const noexcept;
+    bool IsOpen() const noexcept;
+    bool IsReadOnly() const noexcept;
+
+    // Изменяет длину файла и отображения до new_capacity элементов, сохраняя содержимое
+    void Reallocate(size_t new_capacity);
+    // Синхронно записывает в файл первые count элементов (msync)
+    void Flush(size_t count) const;
+    // Снимает отображение, укорачивает файл до size элементов и закрывает его
+    void Close(size_t size);
+
+private:
+    int fd_ = -1;
+    bool read_only_ = true;
+    T *buffer_ = nullptr;
+    size_t capacity_ = 0;
+
+    void Map(size_t capacity);
+    void Unmap() noexcept;
+    void CloseNoThrow() noexcept;
+    static size_t ToBytes(size_t count);
+    [[noreturn]] static void ThrowSystemError(const char *what);
+
+}; // class MappedMemory
+
+template <typename T>
+MappedMemory<T>::MappedMemory(const std::string &path, MapMode mode)
+    : read_only_(mode == MapMode::READ_ONLY)  //
+{
+    fd_ = read_only_ ? ::open(path.c_str(), O_RDONLY | O_CLOEXEC)
+                     : ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        ThrowSystemError("open");
+    }
+    struct stat info {};
+    if (::fstat(fd_, &info) != 0) {
+        const int error = errno;
+        CloseNoThrow();
+        throw std::system_error(error, std::generic_category(), "fstat");
+    }
+    const size_t bytes = static_cast<size_t>(info.st_size);
+    if (bytes % sizeof(T) != 0) {
+        CloseNoThrow();
+        throw std::runtime_error("File size is not a multiple of the element size: " + path);
+    }
+    try {
+        Map(bytes / sizeof(T));
+    } catch (...) {
+        CloseNoThrow();
+        throw;
+    }
+}
+
+template <typename T>
+MappedMemory<T>::MappedMemory(MappedMemory &&other) noexcept
+    : fd_(std::exchange(other.fd_, -1))
+    , read_only_(other.read_only_)
+    , buffer_(std::exchange(other.buffer_, nullptr))
+    , capacity_(std::exchange(other.capacity_, 0))  //
+{
+}
+
+template <typename T>
+MappedMemory<T>::~MappedMemory() {
+    CloseNoThrow();
+}
+
+template <typename T>
+MappedMemory<T>& MappedMemory<T>::operator=(MappedMemory &&rhs) noexcept {
+    if (this != &rhs) {
+        CloseNoThrow();
+        fd_ = std::exchange(rhs.fd_, -1);
+        read_only_ = rhs.read_only_;
+        buffer_ = std::exchange(rhs.buffer_, nullptr);
+        capacity_ = std::exchange(rhs.capacity_, 0);
+    }
+    return *this;
+}
+
+template <typename T>
+T* MappedMemory<T>::operator+(size_t offset) noexcept {
+    // Разрешается получать адрес ячейки памяти, следующей за последним элементом массива
+    assert(offset <= capacity_);
+    return buffer_ + offset;
+}
+
+template <typename T>
+const T* MappedMemory<T>::operator+(size_t offset) const noexcept {
+    return const_cast<MappedMemory&>(*this) + offset;
+}
+
+template <typename T>
+T& MappedMemory<T>::operator[](size_t index) noexcept {
+    assert(index < capacity_ && !read_only_);
+    return buffer_[index];
+}
+
+template <typename T>
+const T& MappedMemory<T>::operator[](size_t index) const noexcept {
+    assert(index < capacity_);
+    return buffer_[index];
+}
+
+template <typename T>
+void MappedMemory<T>::Swap(MappedMemory &other) noexcept {
+    std::swap(fd_, other.fd_);
+    std::swap(read_only_, other.read_only_);
+    std::swap(buffer_, other.buffer_);
+    std::swap(capacity_, other.capacity_);
+}
+
+template <typename T>
+const T* MappedMemory<T>::GetAddress() const noexcept {
+    return buffer_;
+}
+
+template <typename T>
+T* MappedMemory<T>::GetAddress() noexcept {
+    return buffer_;
+}
+
+template <typename T>
+size_t MappedMemory<T>::Capacity() const noexcept {
+    return capacity_;
+}
+
+template <typename T>
+bool MappedMemory<T>::IsOpen() const noexcept {
+    return fd_ >= 0;
+}
+
+template <typename T>
+bool MappedMemory<T>::IsReadOnly() const noexcept {
+    return read_only_;
+}
+
+template <typename T>
+void MappedMemory<T>::Reallocate(size_t new_capacity) {
+    if (!IsOpen() || read_only_) {
+        throw std::logic_error("Mapped file is not open for writing");
+    }
+    if (new_capacity == capacity_) {
+        return;
+    }
+    const size_t new_bytes = ToBytes(new_capacity);
+    if (new_capacity < capacity_) {
+        // отображение сокращается до укорачивания файла, чтобы не осталось страниц за его концом
+        if (new_capacity == 0) {
+            Unmap();
+        } else {
+#if defined(__linux__)
+            void *buf = ::mremap(buffer_, ToBytes(capacity_), new_bytes, 0);
+            if (buf == MAP_FAILED) {
+                ThrowSystemError("mremap");
+            }
+            capacity_ = new_capacity;
+#else
+            Unmap();
+            Map(new_capacity);
+#endif
+        }
+        if (::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0) {
+            ThrowSystemError("ftruncate");
+        }
+        return;
+    }
+    if (::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0) {
+        ThrowSystemError("ftruncate");
+    }
+#if defined(__linux__)
+    if (buffer_ != nullptr) {
+        void *buf = ::mremap(buffer_, ToBytes(capacity_), new_bytes, MREMAP_MAYMOVE);
+        if (buf == MAP_FAILED) {
+            ThrowSystemError("mremap");
+        }
+        buffer_ = static_cast<T*>(buf);
+        capacity_ = new_capacity;
+        return;
+    }
+#endif
+    // содержимое хранится в файле, поэтому новое отображение видит те же данные
+    Unmap();
+    Map(new_capacity);
+}
+
+template <typename T>
+void MappedMemory<T>::Flush(size_t count) const {
+    assert(count <= capacity_);
+    if (buffer_ != nullptr && !read_only_ && count > 0) {
+        if (::msync(buffer_, ToBytes(count), MS_SYNC) != 0) {
+            ThrowSystemError("msync");
+        }
+    }
+}
+
+template <typename T>
+void MappedMemory<T>::Close(size_t size) {
+    if (!IsOpen()) {
+        return;
+    }
+    assert(size <= capacity_);
+    Unmap();
+    const int fd = std::exchange(fd_, -1);
+    const bool truncate_failed = !read_only_ && ::ftruncate(fd, static_cast<off_t>(ToBytes(size))) != 0;
+    const int error = errno;
+    ::close(fd);
+    if (truncate_failed) {
+        throw std::system_error(error, std::generic_category(), "ftruncate");
+    }
+}
+
+template <typename T>
+void MappedMemory<T>::Map(size_t capacity) {
+    assert(buffer_ == nullptr);
+    if (capacity == 0) {
+        capacity_ = 0;
+        return;
+    }
+    const int protection = read_only_ ? PROT_READ : PROT_READ | PROT_WRITE;
+    void *buf = ::mmap(nullptr, ToBytes(capacity), protection, MAP_SHARED, fd_, 0);
+    if (buf == MAP_FAILED) {
+        ThrowSystemError("mmap");
+    }
+    buffer_ = static_cast<T*>(buf);
+    capacity_ = capacity;
+}
+
+template <typename T>
+void MappedMemory<T>::Unmap() noexcept {
+    if (buffer_ != nullptr) {
+        ::munmap(buffer_, capacity_ * sizeof(T));
+    }
+    buffer_ = nullptr;
+    capacity_ = 0;
+}
+
+template <typename T>
+void MappedMemory<T>::CloseNoThrow() noexcept {
+    Unmap();
+    if (fd_ >= 0) {
+        ::close(std::exchange(fd_, -1));
+    }
+}
+
+template <typename T>
+size_t MappedMemory<T>::ToBytes(size_t count) {
+    if (count > static_cast<size_t>(std::numeric_limits<off_t>::max()) / sizeof(T)) {
+        throw std::length_error("Mapped file is too large");
+    }
+    return count * sizeof(T);
+}
+
+template <typename T>
+void MappedMemory<T>::ThrowSystemError(const char *what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// ---------------------------------- MAPPED VECTOR -------------------------------------
+
+// Вектор тривиально копируемых элементов, хранящихся в файле, отображённом в память.
+// Открытие существующего файла не читает и не копирует данные: страницы подгружаются при
+// обращении, а при MapMode::READ_ONLY несколько процессов используют одну копию данных в кэше
+// страниц. Файл содержит элементы подряд без заголовка; пока файл открыт, его длина равна ёмкости,
+// а при закрытии он укорачивается до Size() элементов
+template <typename T, typename Growth = DoublingGrowth>
+class MappedVector {
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    // Неконстантные begin, end и operator[] дают право записи в файл и выбрасывают
+    // std::logic_error в режиме READ_ONLY; для чтения используйте константный вектор
+    iterator begin();
+    iterator end();
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    MappedVector() noexcept = default;
+    // Открывает файл path; размер вектора равен числу элементов в файле
+    explicit MappedVector(const std::string &path, MapMode mode = MapMode::READ_WRITE);
+    MappedVector(MappedVector &&other) noexcept;
+    MappedVector& operator=(MappedVector &&rhs) noexcept;
+
+    // закрывает файл; ошибки укорачивания файла при этом игнорируются
+    ~MappedVector();
+
+    void Swap(MappedVector &other) noexcept;
+
+    size_t Size() const noexcept;
+    size_t Capacity() const noexcept;
+    bool IsReadOnly() const noexcept;
+
+    // Следующие методы изменяют файл и выбрасывают std::logic_error в режиме READ_ONLY
+    void Reserve(size_t new_capacity);
+    void Resize(size_t new_size);
+    void ShrinkToFit();
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+    T& PushBack(const T &value);
+    // добавляет count элементов из data одним копированием
+    void Append(const T *data, size_t count);
+
+    void Clear() noexcept;
+    void PopBack() noexcept;
+
+    // Синхронно записывает элементы в файл (msync)
+    void Flush() const;
+    // Укорачивает файл до Size() элементов и закрывает его; вектор становится пустым
+    void Close();
+
+    const T& operator[](size_t index) const noexcept;
+    T& operator[](size_t index);
+
+private:
+    MappedMemory<T> data_;
+    size_t size_ = 0;
+
+    void RequireWritable() const;
+    // в отличие от RequireWritable допускает закрытый вектор, у которого нет элементов
+    void RequireNotReadOnly() const;
+    void Grow(size_t required);
+
+}; // class MappedVector
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::iterator MappedVector<T, Growth>::begin() {
+    RequireNotReadOnly();
+    return data_.GetAddress();
+}
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::iterator MappedVector<T, Growth>::end() {
+    RequireNotReadOnly();
+    return data_ + size_;
+}
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::const_iterator MappedVector<T, Growth>::begin() const noexcept {
+    return data_.GetAddress();
+}
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::const_iterator MappedVector<T, Growth>::end() const noexcept {
+    return data_ + size_;
+}
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::const_iterator MappedVector<T, Growth>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::const_iterator MappedVector<T, Growth>::cend() const noexcept {
+    return end();
+}
+
+template <typename T, typename Growth>
+MappedVector<T, Growth>::MappedVector(const std::string &path, MapMode mode)
+    : data_(path, mode)
+    , size_(data_.Capacity())  //
+{
+}
+
+template <typename T, typename Growth>
+MappedVector<T, Growth>::MappedVector(MappedVector &&other) noexcept
+    : data_(std::move(other.data_))
+    , size_(std::exchange(other.size_, 0))  //
+{
+}
+
+template <typename T, typename Growth>
+MappedVector<T, Growth>& MappedVector<T, Growth>::operator=(MappedVector &&rhs) noexcept {
+    if (this != &rhs) {
+        MappedVector rhs_moved(std::move(rhs));
+        Swap(rhs_moved);
+    }
+    return *this;
+}
+
+template <typename T, typename Growth>
+MappedVector<T, Growth>::~MappedVector() {
+    try {
+        Close();
+    } catch (const std::system_error&) {
+    }
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Swap(MappedVector &other) noexcept {
+    data_.Swap(other.data_);
+    std::swap(size_, other.size_);
+}
+
+template <typename T, typename Growth>
+size_t MappedVector<T, Growth>::Size() const noexcept {
+    return size_;
+}
+
+template <typename T, typename Growth>
+size_t MappedVector<T, Growth>::Capacity() const noexcept {
+    return data_.Capacity();
+}
+
+template <typename T, typename Growth>
+bool MappedVector<T, Growth>::IsReadOnly() const noexcept {
+    return data_.IsReadOnly();
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Reserve(size_t new_capacity) {
+    RequireWritable();
+    if (new_capacity > data_.Capacity()) {
+        data_.Reallocate(new_capacity);
+    }
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Resize(size_t new_size) {
+    RequireWritable();
+    if (new_size > size_) {
+        Reserve(new_size);
+        std::uninitialized_value_construct_n(data_ + size_, new_size - size_);
+    }
+    size_ = new_size;
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Clear() noexcept {
+    size_ = 0;
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::ShrinkToFit() {
+    RequireWritable();
+    data_.Reallocate(size_);
+}
+
+template <typename T, typename Growth>
+template <typename... Args>
+T& MappedVector<T, Growth>::EmplaceBack(Args&&... args) {
+    RequireWritable();
+    if (size_ == data_.Capacity()) {
+        // элемент создаётся до переотображения, так как args может ссылаться на элемент вектора
+        T value(std::forward<Args>(args)...);
+        Grow(size_ + 1);
+        return *new (data_ + size_++) T(value);
+    }
+    return *new (data_ + size_++) T(std::forward<Args>(args)...);
+}
+
+template <typename T, typename Growth>
+T& MappedVector<T, Growth>::PushBack(const T &value) {
+    return EmplaceBack(value);
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::PopBack() noexcept {
+    assert(size_ > 0);
+    --size_;
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Append(const T *data, size_t count) {
+    RequireWritable();
+    if (count == 0) {
+        return;
+    }
+    assert(data + count <= cbegin() || data >= cbegin() + Capacity());
+    if (size_ + count > data_.Capacity()) {
+        Grow(size_ + count);
+    }
+    std::memcpy(static_cast<void*>(data_ + size_), data, count * sizeof(T));
+    size_ += count;
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Flush() const {
+    data_.Flush(size_);
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Close() {
+    const size_t size = std::exchange(size_, 0);
+    data_.Close(size);
+}
+
+template <typename T, typename Growth>
+const T& MappedVector<T, Growth>::operator[](size_t index) const noexcept {
+    assert(index < size_);
+    return data_[index];
+}
+
+template <typename T, typename Growth>
+T& MappedVector<T, Growth>::operator[](size_t index) {
+    RequireNotReadOnly();
+    assert(index < size_);
+    return data_[index];
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::RequireWritable() const {
+    if (!data_.IsOpen() || data_.IsReadOnly()) {
+        throw std::logic_error("MappedVector is not open for writing");
+    }
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::RequireNotReadOnly() const {
+    if (data_.IsOpen() && data_.IsReadOnly()) {
+        throw std::logic_error("MappedVector is opened read-only");
+    }
+}
+
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Grow(size_t required) {
+    data_.Reallocate(Growth::NextCapacity(data_.Capacity(), required, sizeof(T)));
+}
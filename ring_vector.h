@@ -0,0 +1,398 @@
+#pragma once
+#include "vector.h"
+
+#include <limits>
+#include <stdexcept>
+
+// ---------------------------------- RING VECTOR ---------------------------------------
+
+// Кольцевой буфер на RawMemory для очередей: элементы занимают size позиций, начиная с head,
+// с переходом через конец буфера. Добавление и удаление с обоих концов выполняются за O(1) без
+// сдвига элементов. Ёмкость - степень двойки, поэтому позиция в буфере вычисляется маской.
+// При росте элементы переносятся не более чем двумя непрерывными участками, а AsSpans отдаёт
+// эти участки, например, для writev
+template <typename T>
+class RingVector {
+public:
+    using value_type = T;
+    using iterator = IndexIterator<RingVector, T>;
+    using const_iterator = IndexIterator<const RingVector, const T>;
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    RingVector() noexcept = default;
+    RingVector(std::initializer_list<T> init);
+    RingVector(const RingVector &other);
+    RingVector(RingVector &&other) noexcept;
+
+    RingVector& operator=(const RingVector &rhs);
+    RingVector& operator=(RingVector &&rhs) noexcept;
+
+    ~RingVector();
+
+    void Swap(RingVector &other) noexcept;
+
+    size_t Size() const noexcept;
+    size_t Capacity() const noexcept;
+    // Ёмкость округляется вверх до степени двойки; выбрасывает std::length_error,
+    // если такая степень двойки не помещается в size_t
+    void Reserve(size_t new_capacity);
+    void Clear() noexcept;
+    void ShrinkToFit();
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+    T& PushBack(const T &value);
+    T& PushBack(T &&value);
+    template <typename... Args>
+    T& EmplaceFront(Args&&... args);
+    T& PushFront(const T &value);
+    T& PushFront(T &&value);
+    void PopBack() noexcept;
+    void PopFront() noexcept;
+
+    const T& Front() const noexcept;
+    T& Front() noexcept;
+    const T& Back() const noexcept;
+    T& Back() noexcept;
+
+    // элемент с индексом index, считая от начала очереди
+    const T& operator[](size_t index) const noexcept;
+    T& operator[](size_t index) noexcept;
+
+    // Элементы очереди по порядку в виде двух непрерывных участков; второй пуст,
+    // если элементы не переходят через конец буфера
+    std::pair<Span<T>, Span<T>> AsSpans() noexcept;
+    std::pair<Span<const T>, Span<const T>> AsSpans() const noexcept;
+
+private:
+    RawMemory<T> data_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+
+    static constexpr size_t MAX_CAPACITY = (std::numeric_limits<size_t>::max() >> 1) + 1;
+
+    static size_t RoundUpToPowerOfTwo(size_t n);
+    size_t Position(size_t index) const noexcept;
+    size_t NextCapacity() const;
+
+    // Переносит элементы в начало new_data. При исключении new_data остаётся
+    // неинициализированной, а элементы - нетронутыми
+    void RelocateTo(RawMemory<T> &new_data);
+    void Reallocate(size_t new_capacity);
+    // создаёт элемент в новом буфере (в конце очереди или перед её началом) и переносит в него
+    // остальные элементы
+    template <bool FRONT, typename... Args>
+    T& EmplaceWithReallocate(Args&&... args);
+
+}; // class RingVector
+
+template <typename T>
+typename RingVector<T>::iterator RingVector<T>::begin() noexcept {
+    return {this, 0};
+}
+
+template <typename T>
+typename RingVector<T>::iterator RingVector<T>::end() noexcept {
+    return {this, size_};
+}
+
+template <typename T>
+typename RingVector<T>::const_iterator RingVector<T>::begin() const noexcept {
+    return {this, 0};
+}
+
+template <typename T>
+typename RingVector<T>::const_iterator RingVector<T>::end() const noexcept {
+    return {this, size_};
+}
+
+template <typename T>
+typename RingVector<T>::const_iterator RingVector<T>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename T>
+typename RingVector<T>::const_iterator RingVector<T>::cend() const noexcept {
+    return end();
+}
+
+// Конструкторы делегируют конструктору по умолчанию, чтобы при исключении деструктор
+// удалил уже созданные элементы
+template <typename T>
+RingVector<T>::RingVector(std::initializer_list<T> init)
+    : RingVector()  //
+{
+    Reserve(init.size());
+    for (const T &value : init) {
+        EmplaceBack(value);
+    }
+}
+
+template <typename T>
+RingVector<T>::RingVector(const RingVector &other)
+    : RingVector()  //
+{
+    Reserve(other.size_);
+    for (const T &value : other) {
+        EmplaceBack(value);
+    }
+}
+
+template <typename T>
+RingVector<T>::RingVector(RingVector &&other) noexcept
+    : data_(std::move(other.data_))
+    , head_(std::exchange(other.head_, 0))
+    , size_(std::exchange(other.size_, 0))  //
+{
+}
+
+template <typename T>
+RingVector<T>& RingVector<T>::operator=(const RingVector &rhs) {
+    if (this != &rhs) {
+        RingVector rhs_copy(rhs);
+        Swap(rhs_copy);
+    }
+    return *this;
+}
+
+template <typename T>
+RingVector<T>& RingVector<T>::operator=(RingVector &&rhs) noexcept {
+    if (this != &rhs) {
+        Clear();
+        data_ = std::move(rhs.data_);
+        head_ = std::exchange(rhs.head_, 0);
+        size_ = std::exchange(rhs.size_, 0);
+    }
+    return *this;
+}
+
+template <typename T>
+RingVector<T>::~RingVector() {
+    Clear();
+}
+
+template <typename T>
+void RingVector<T>::Swap(RingVector &other) noexcept {
+    data_.Swap(other.data_);
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+}
+
+template <typename T>
+size_t RingVector<T>::Size() const noexcept {
+    return size_;
+}
+
+template <typename T>
+size_t RingVector<T>::Capacity() const noexcept {
+    return data_.Capacity();
+}
+
+template <typename T>
+void RingVector<T>::Reserve(size_t new_capacity) {
+    if (new_capacity > Capacity()) {
+        Reallocate(RoundUpToPowerOfTwo(new_capacity));
+    }
+}
+
+template <typename T>
+void RingVector<T>::Clear() noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        auto [first, second] = AsSpans();
+        std::destroy(first.begin(), first.end());
+        std::destroy(second.begin(), second.end());
+    }
+    head_ = 0;
+    size_ = 0;
+}
+
+template <typename T>
+void RingVector<T>::ShrinkToFit() {
+    const size_t new_capacity = size_ == 0 ? 0 : RoundUpToPowerOfTwo(size_);
+    if (new_capacity < Capacity()) {
+        Reallocate(new_capacity);
+    }
+}
+
+template <typename T>
+template <typename... Args>
+T& RingVector<T>::EmplaceBack(Args&&... args) {
+    if (size_ == Capacity()) {
+        return EmplaceWithReallocate<false>(std::forward<Args>(args)...);
+    }
+    T *elem = new (data_ + Position(size_)) T(std::forward<Args>(args)...);
+    ++size_;
+    return *elem;
+}
+
+template <typename T>
+T& RingVector<T>::PushBack(const T &value) {
+    return EmplaceBack(value);
+}
+
+template <typename T>
+T& RingVector<T>::PushBack(T &&value) {
+    return EmplaceBack(std::move(value));
+}
+
+template <typename T>
+template <typename... Args>
+T& RingVector<T>::EmplaceFront(Args&&... args) {
+    if (size_ == Capacity()) {
+        return EmplaceWithReallocate<true>(std::forward<Args>(args)...);
+    }
+    const size_t new_head = (head_ + Capacity() - 1) & (Capacity() - 1);
+    T *elem = new (data_ + new_head) T(std::forward<Args>(args)...);
+    head_ = new_head;
+    ++size_;
+    return *elem;
+}
+
+template <typename T>
+T& RingVector<T>::PushFront(const T &value) {
+    return EmplaceFront(value);
+}
+
+template <typename T>
+T& RingVector<T>::PushFront(T &&value) {
+    return EmplaceFront(std::move(value));
+}
+
+template <typename T>
+void RingVector<T>::PopBack() noexcept {
+    assert(size_ > 0);
+    std::destroy_at(&Back());
+    --size_;
+}
+
+template <typename T>
+void RingVector<T>::PopFront() noexcept {
+    assert(size_ > 0);
+    std::destroy_at(&Front());
+    head_ = (head_ + 1) & (Capacity() - 1);
+    --size_;
+}
+
+template <typename T>
+const T& RingVector<T>::Front() const noexcept {
+    return (*this)[0];
+}
+
+template <typename T>
+T& RingVector<T>::Front() noexcept {
+    return (*this)[0];
+}
+
+template <typename T>
+const T& RingVector<T>::Back() const noexcept {
+    return (*this)[size_ - 1];
+}
+
+template <typename T>
+T& RingVector<T>::Back() noexcept {
+    return (*this)[size_ - 1];
+}
+
+template <typename T>
+const T& RingVector<T>::operator[](size_t index) const noexcept {
+    return const_cast<RingVector&>(*this)[index];
+}
+
+template <typename T>
+T& RingVector<T>::operator[](size_t index) noexcept {
+    assert(index < size_);
+    return data_[Position(index)];
+}
+
+template <typename T>
+std::pair<Span<T>, Span<T>> RingVector<T>::AsSpans() noexcept {
+    const size_t first = std::min(size_, Capacity() - head_);
+    return {Span<T>(data_ + head_, first), Span<T>(data_.GetAddress(), size_ - first)};
+}
+
+template <typename T>
+std::pair<Span<const T>, Span<const T>> RingVector<T>::AsSpans() const noexcept {
+    return const_cast<RingVector&>(*this).AsSpans();
+}
+
+template <typename T>
+size_t RingVector<T>::RoundUpToPowerOfTwo(size_t n) {
+    if (n > MAX_CAPACITY) {
+        throw std::length_error("RingVector capacity is too large");
+    }
+    size_t power = 1;
+    while (power < n) {
+        power *= 2;
+    }
+    return power;
+}
+
+template <typename T>
+size_t RingVector<T>::Position(size_t index) const noexcept {
+    return (head_ + index) & (Capacity() - 1);
+}
+
+template <typename T>
+size_t RingVector<T>::NextCapacity() const {
+    if (Capacity() == MAX_CAPACITY) {
+        throw std::length_error("RingVector capacity is too large");
+    }
+    return Capacity() == 0 ? 1 : Capacity() * 2;
+}
+
+template <typename T>
+void RingVector<T>::RelocateTo(RawMemory<T> &new_data) {
+    auto [first, second] = AsSpans();
+    vector_stats::OnRelocate<T>(size_);
+    if constexpr (IsTriviallyRelocatableV<T> || std::is_nothrow_move_constructible_v<T>
+                  || !std::is_copy_constructible_v<T>) {
+        RelocateElements(first.Data(), first.Size(), new_data.GetAddress());
+        RelocateElements(second.Data(), second.Size(), new_data + first.Size());
+    } else {
+        // элементы удаляются только после успешного копирования обоих участков
+        T *copied = std::uninitialized_copy(first.begin(), first.end(), new_data.GetAddress());
+        try {
+            std::uninitialized_copy(second.begin(), second.end(), copied);
+        } catch (...) {
+            std::destroy_n(new_data.GetAddress(), first.Size());
+            throw;
+        }
+        std::destroy(first.begin(), first.end());
+        std::destroy(second.begin(), second.end());
+    }
+}
+
+template <typename T>
+void RingVector<T>::Reallocate(size_t new_capacity) {
+    assert(new_capacity >= size_);
+    RawMemory<T> new_data(new_capacity);
+    RelocateTo(new_data);
+    data_.Swap(new_data);
+    head_ = 0;
+}
+
+template <typename T>
+template <bool FRONT, typename... Args>
+T& RingVector<T>::EmplaceWithReallocate(Args&&... args) {
+    RawMemory<T> new_data(NextCapacity());
+    // элемент создаётся до переноса, так как аргументы могут ссылаться на элементы очереди;
+    // новый первый элемент занимает последнюю позицию нового буфера
+    const size_t slot = FRONT ? new_data.Capacity() - 1 : size_;
+    T *elem = new (new_data + slot) T(std::forward<Args>(args)...);
+    try {
+        RelocateTo(new_data);
+    } catch (...) {
+        std::destroy_at(elem);
+        throw;
+    }
+    data_.Swap(new_data);
+    head_ = FRONT ? slot : 0;
+    ++size_;
+    return *elem;
+}
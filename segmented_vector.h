@@ -0,0 +1,356 @@
+#pragma once
+#include "vector.h"
+
+// -------------------------------- SEGMENTED VECTOR ------------------------------------
+
+// Число элементов в блоке SegmentedVector по умолчанию: блок занимает около страницы памяти
+template <typename T>
+inline constexpr size_t SEGMENT_BLOCK_SIZE = std::max<size_t>(16, PAGE_SIZE / sizeof(T));
+
+// Вектор из блоков RawMemory по BLOCK_SIZE элементов и индекса блоков. При росте выделяется
+// только новый блок, а элементы не переносятся: добавление в конец выполняется за амортизированное
+// O(1) без перемещений, ссылки и указатели на элементы остаются действительными до удаления
+// элемента или вставки перед ним. ForEachBlock отдаёт элементы непрерывными участками, которые
+// компилятор может векторизовать
+template <typename T, size_t BLOCK_SIZE = SEGMENT_BLOCK_SIZE<T>>
+class SegmentedVector {
+    static_assert(BLOCK_SIZE > 0, "Block size must be positive");
+
+public:
+    using value_type = T;
+    using iterator = IndexIterator<SegmentedVector, T>;
+    using const_iterator = IndexIterator<const SegmentedVector, const T>;
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    SegmentedVector() noexcept = default;
+    explicit SegmentedVector(size_t size);
+    SegmentedVector(std::initializer_list<T> init);
+    SegmentedVector(const SegmentedVector &other);
+    SegmentedVector(SegmentedVector &&other) noexcept;
+
+    SegmentedVector& operator=(const SegmentedVector &rhs);
+    SegmentedVector& operator=(SegmentedVector &&rhs) noexcept;
+
+    ~SegmentedVector();
+
+    void Swap(SegmentedVector &other) noexcept;
+
+    size_t Size() const noexcept;
+    size_t Capacity() const noexcept;
+    // число выделенных блоков
+    size_t BlockCount() const noexcept;
+    // Выделяет блоки под new_capacity элементов. Существующие элементы не переносятся
+    void Reserve(size_t new_capacity);
+    void Resize(size_t new_size);
+    void Clear() noexcept;
+    // освобождает блоки, не занятые элементами
+    void ShrinkToFit();
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+    T& PushBack(const T &value);
+    T& PushBack(T &&value);
+    void PopBack() noexcept;
+
+    // Вставка и удаление в середине сдвигают последующие элементы на одну позицию
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args);
+    iterator Insert(const_iterator pos, const T &value);
+    iterator Insert(const_iterator pos, T &&value);
+    iterator Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>);
+    iterator Erase(const_iterator first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+    const T& operator[](size_t index) const noexcept;
+    T& operator[](size_t index) noexcept;
+
+    // Вызывает op(data, count) для каждого непустого блока по порядку: data указывает на count
+    // элементов, расположенных в памяти подряд
+    template <typename Operation>
+    void ForEachBlock(Operation op);
+    template <typename Operation>
+    void ForEachBlock(Operation op) const;
+
+private:
+    Vector<RawMemory<T>> blocks_;
+    size_t size_ = 0;
+
+    // добавляет блок, если все выделенные блоки заполнены
+    void EnsureSpaceForBack();
+    void DestroyTail(size_t new_size) noexcept;
+
+}; // class SegmentedVector
+
+template <typename T, size_t BLOCK_SIZE>
+typename SegmentedVector<T, BLOCK_SIZE>::iterator SegmentedVector<T, BLOCK_SIZE>::begin() noexcept {
+    return {this, 0};
+}
+
+template <typename T, size_t BLOCK_SIZE>
+typename SegmentedVector<T, BLOCK_SIZE>::iterator SegmentedVector<T, BLOCK_SIZE>::end() noexcept {
+    return {this, size_};
+}
+
+template <typename T, size_t BLOCK_SIZE>
+typename SegmentedVector<T, BLOCK_SIZE>::const_iterator SegmentedVector<T, BLOCK_SIZE>::begin() const noexcept {
+    return {this, 0};
+}
+
+template <typename T, size_t BLOCK_SIZE>
+typename SegmentedVector<T, BLOCK_SIZE>::const_iterator SegmentedVector<T, BLOCK_SIZE>::end() const noexcept {
+    return {this, size_};
+}
+
+template <typename T, size_t BLOCK_SIZE>
+typename SegmentedVector<T, BLOCK_SIZE>::const_iterator SegmentedVector<T, BLOCK_SIZE>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename T, size_t BLOCK_SIZE>
+typename SegmentedVector<T, BLOCK_SIZE>::const_iterator SegmentedVector<T, BLOCK_SIZE>::cend() const noexcept {
+    return end();
+}
+
+// Конструкторы делегируют конструктору по умолчанию, чтобы при исключении деструктор
+// удалил уже созданные элементы
+template <typename T, size_t BLOCK_SIZE>
+SegmentedVector<T, BLOCK_SIZE>::SegmentedVector(size_t size)
+    : SegmentedVector()  //
+{
+    Resize(size);
+}
+
+template <typename T, size_t BLOCK_SIZE>
+SegmentedVector<T, BLOCK_SIZE>::SegmentedVector(std::initializer_list<T> init)
+    : SegmentedVector()  //
+{
+    Reserve(init.size());
+    for (const T &value : init) {
+        EmplaceBack(value);
+    }
+}
+
+template <typename T, size_t BLOCK_SIZE>
+SegmentedVector<T, BLOCK_SIZE>::SegmentedVector(const SegmentedVector &other)
+    : SegmentedVector()  //
+{
+    Reserve(other.size_);
+    other.ForEachBlock([this](const T *data, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            EmplaceBack(data[i]);
+        }
+    });
+}
+
+template <typename T, size_t BLOCK_SIZE>
+SegmentedVector<T, BLOCK_SIZE>::SegmentedVector(SegmentedVector &&other) noexcept
+    : blocks_(std::move(other.blocks_))
+    , size_(std::exchange(other.size_, 0))  //
+{
+}
+
+template <typename T, size_t BLOCK_SIZE>
+SegmentedVector<T, BLOCK_SIZE>& SegmentedVector<T, BLOCK_SIZE>::operator=(const SegmentedVector &rhs) {
+    if (this != &rhs) {
+        SegmentedVector rhs_copy(rhs);
+        Swap(rhs_copy);
+    }
+    return *this;
+}
+
+template <typename T, size_t BLOCK_SIZE>
+SegmentedVector<T, BLOCK_SIZE>& SegmentedVector<T, BLOCK_SIZE>::operator=(SegmentedVector &&rhs) noexcept {
+    if (this != &rhs) {
+        Clear();
+        blocks_ = std::move(rhs.blocks_);
+        size_ = std::exchange(rhs.size_, 0);
+    }
+    return *this;
+}
+
+template <typename T, size_t BLOCK_SIZE>
+SegmentedVector<T, BLOCK_SIZE>::~SegmentedVector() {
+    Clear();
+}
+
+template <typename T, size_t BLOCK_SIZE>
+void SegmentedVector<T, BLOCK_SIZE>::Swap(SegmentedVector &other) noexcept {
+    blocks_.Swap(other.blocks_);
+    std::swap(size_, other.size_);
+}
+
+template <typename T, size_t BLOCK_SIZE>
+size_t SegmentedVector<T, BLOCK_SIZE>::Size() const noexcept {
+    return size_;
+}
+
+template <typename T, size_t BLOCK_SIZE>
+size_t SegmentedVector<T, BLOCK_SIZE>::Capacity() const noexcept {
+    return blocks_.Size() * BLOCK_SIZE;
+}
+
+template <typename T, size_t BLOCK_SIZE>
+size_t SegmentedVector<T, BLOCK_SIZE>::BlockCount() const noexcept {
+    return blocks_.Size();
+}
+
+template <typename T, size_t BLOCK_SIZE>
+void SegmentedVector<T, BLOCK_SIZE>::Reserve(size_t new_capacity) {
+    if (new_capacity <= Capacity()) {
+        return;
+    }
+    const size_t block_count = (new_capacity - 1) / BLOCK_SIZE + 1;
+    blocks_.Reserve(block_count);
+    while (blocks_.Size() < block_count) {
+        blocks_.EmplaceBack(BLOCK_SIZE);
+    }
+}
+
+template <typename T, size_t BLOCK_SIZE>
+void SegmentedVector<T, BLOCK_SIZE>::Resize(size_t new_size) {
+    if (new_size < size_) {
+        DestroyTail(new_size);
+        return;
+    }
+    Reserve(new_size);
+    while (size_ < new_size) {
+        new (blocks_[size_ / BLOCK_SIZE] + size_ % BLOCK_SIZE) T();
+        ++size_;
+    }
+}
+
+template <typename T, size_t BLOCK_SIZE>
+void SegmentedVector<T, BLOCK_SIZE>::Clear() noexcept {
+    DestroyTail(0);
+}
+
+template <typename T, size_t BLOCK_SIZE>
+void SegmentedVector<T, BLOCK_SIZE>::ShrinkToFit() {
+    const size_t used_blocks = (size_ + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    while (blocks_.Size() > used_blocks) {
+        blocks_.PopBack();
+    }
+    blocks_.ShrinkToFit();
+}
+
+template <typename T, size_t BLOCK_SIZE>
+template <typename... Args>
+T& SegmentedVector<T, BLOCK_SIZE>::EmplaceBack(Args&&... args) {
+    // элементы не переносятся, поэтому args может ссылаться на элемент самого вектора
+    EnsureSpaceForBack();
+    T *elem = new (blocks_[size_ / BLOCK_SIZE] + size_ % BLOCK_SIZE) T(std::forward<Args>(args)...);
+    ++size_;
+    return *elem;
+}
+
+template <typename T, size_t BLOCK_SIZE>
+T& SegmentedVector<T, BLOCK_SIZE>::PushBack(const T &value) {
+    return EmplaceBack(value);
+}
+
+template <typename T, size_t BLOCK_SIZE>
+T& SegmentedVector<T, BLOCK_SIZE>::PushBack(T &&value) {
+    return EmplaceBack(std::move(value));
+}
+
+template <typename T, size_t BLOCK_SIZE>
+void SegmentedVector<T, BLOCK_SIZE>::PopBack() noexcept {
+    assert(size_ > 0);
+    DestroyTail(size_ - 1);
+}
+
+template <typename T, size_t BLOCK_SIZE>
+template <typename... Args>
+typename SegmentedVector<T, BLOCK_SIZE>::iterator
+SegmentedVector<T, BLOCK_SIZE>::Emplace(const_iterator pos, Args&&... args) {
+    assert(pos >= cbegin() && pos <= cend());
+    const size_t index = static_cast<size_t>(pos - cbegin());
+    if (index == size_) {
+        EmplaceBack(std::forward<Args>(args)...);
+        return {this, index};
+    }
+    // временный объект создаётся до сдвига, так как args может ссылаться на сдвигаемые элементы
+    T value(std::forward<Args>(args)...);
+    EmplaceBack(std::move((*this)[size_ - 1]));
+    std::move_backward(begin() + static_cast<std::ptrdiff_t>(index), end() - 2, end() - 1);
+    (*this)[index] = std::move(value);
+    return {this, index};
+}
+
+template <typename T, size_t BLOCK_SIZE>
+typename SegmentedVector<T, BLOCK_SIZE>::iterator SegmentedVector<T, BLOCK_SIZE>::Insert(const_iterator pos, const T &value) {
+    return Emplace(pos, value);
+}
+
+template <typename T, size_t BLOCK_SIZE>
+typename SegmentedVector<T, BLOCK_SIZE>::iterator SegmentedVector<T, BLOCK_SIZE>::Insert(const_iterator pos, T &&value) {
+    return Emplace(pos, std::move(value));
+}
+
+template <typename T, size_t BLOCK_SIZE>
+typename SegmentedVector<T, BLOCK_SIZE>::iterator
+SegmentedVector<T, BLOCK_SIZE>::Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    return Erase(pos, pos + 1);
+}
+
+template <typename T, size_t BLOCK_SIZE>
+typename SegmentedVector<T, BLOCK_SIZE>::iterator
+SegmentedVector<T, BLOCK_SIZE>::Erase(const_iterator first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    assert(first >= cbegin() && first <= last && last <= cend());
+    const auto index = first - cbegin();
+    const auto count = last - first;
+    if (count > 0) {
+        std::move(begin() + index + count, end(), begin() + index);
+        DestroyTail(size_ - static_cast<size_t>(count));
+    }
+    return begin() + index;
+}
+
+template <typename T, size_t BLOCK_SIZE>
+const T& SegmentedVector<T, BLOCK_SIZE>::operator[](size_t index) const noexcept {
+    return const_cast<SegmentedVector&>(*this)[index];
+}
+
+template <typename T, size_t BLOCK_SIZE>
+T& SegmentedVector<T, BLOCK_SIZE>::operator[](size_t index) noexcept {
+    assert(index < size_);
+    return blocks_[index / BLOCK_SIZE][index % BLOCK_SIZE];
+}
+
+template <typename T, size_t BLOCK_SIZE>
+template <typename Operation>
+void SegmentedVector<T, BLOCK_SIZE>::ForEachBlock(Operation op) {
+    for (size_t first = 0, block = 0; first < size_; first += BLOCK_SIZE, ++block) {
+        op(blocks_[block].GetAddress(), std::min(BLOCK_SIZE, size_ - first));
+    }
+}
+
+template <typename T, size_t BLOCK_SIZE>
+template <typename Operation>
+void SegmentedVector<T, BLOCK_SIZE>::ForEachBlock(Operation op) const {
+    for (size_t first = 0, block = 0; first < size_; first += BLOCK_SIZE, ++block) {
+        op(blocks_[block].GetAddress(), std::min(BLOCK_SIZE, size_ - first));
+    }
+}
+
+template <typename T, size_t BLOCK_SIZE>
+void SegmentedVector<T, BLOCK_SIZE>::EnsureSpaceForBack() {
+    if (size_ == Capacity()) {
+        blocks_.EmplaceBack(BLOCK_SIZE);
+    }
+}
+
+template <typename T, size_t BLOCK_SIZE>
+void SegmentedVector<T, BLOCK_SIZE>::DestroyTail(size_t new_size) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (size_t index = new_size; index < size_; ++index) {
+            std::destroy_at(blocks_[index / BLOCK_SIZE] + index % BLOCK_SIZE);
+        }
+    }
+    size_ = new_size;
+}
@@ -0,0 +1,165 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+// --------------------------------- SHARDED VECTOR -------------------------------------
+
+// Сборщик элементов из нескольких потоков: каждый поток добавляет элементы в свой Vector (шард)
+// без синхронизации, а MergeInto после завершения добавления переносит все шарды в один вектор.
+// Блокировка берётся только при первом обращении потока к контейнеру. Порядок элементов одного
+// потока сохраняется, порядок шардов разных потоков не определён
+template <typename T>
+class ShardedVector {
+public:
+    ShardedVector() = default;
+    ShardedVector(const ShardedVector&) = delete;
+    ShardedVector& operator=(const ShardedVector&) = delete;
+
+    // Добавляют элемент в шард текущего потока. Потокобезопасны
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+    T& PushBack(const T &value);
+    T& PushBack(T &&value);
+
+    // шард текущего потока (например, для Reserve под ожидаемое число элементов)
+    Vector<T>& LocalShard();
+
+    // Следующие методы не должны вызываться одновременно с добавлением элементов
+
+    // суммарное число элементов во всех шардах
+    size_t Size() const;
+    // Переносит элементы всех шардов в конец out, выделяя память под них один раз.
+    // Шарды становятся пустыми, но сохраняют ёмкость для следующего цикла сбора
+    void MergeInto(Vector<T> &out);
+    // удаляет элементы всех шардов
+    void Clear() noexcept;
+
+private:
+    // шард занимает отдельные кэш-линии, чтобы потоки не мешали друг другу
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        explicit Shard(std::thread::id owner) noexcept : owner(owner) {}
+
+        Vector<T> items;
+        std::thread::id owner;
+    };
+
+    // запись кэша потока: шард потока в контейнере с идентификатором id
+    struct CacheEntry {
+        uint64_t id = 0;
+        Shard *shard = nullptr;
+    };
+
+    // размер кэша шардов потока, при превышении которого кэш очищается
+    static constexpr size_t MAX_CACHED_SHARDS = 64;
+
+    // идентификаторы не переиспользуются, поэтому записи кэша разрушенных контейнеров
+    // никогда не совпадут с живыми
+    inline static std::atomic<uint64_t> next_id_{1};
+
+    const uint64_t id_ = next_id_.fetch_add(1, std::memory_order_relaxed);
+    mutable std::mutex mutex_;
+    Vector<std::unique_ptr<Shard>> shards_;
+
+    // поиск шарда текущего потока в кэше потока, а при промахе - среди шардов контейнера
+    Shard& FindShard();
+    Shard& FindShardSlow();
+
+}; // class ShardedVector
+
+template <typename T>
+template <typename... Args>
+T& ShardedVector<T>::EmplaceBack(Args&&... args) {
+    return FindShard().items.EmplaceBack(std::forward<Args>(args)...);
+}
+
+template <typename T>
+T& ShardedVector<T>::PushBack(const T &value) {
+    return EmplaceBack(value);
+}
+
+template <typename T>
+T& ShardedVector<T>::PushBack(T &&value) {
+    return EmplaceBack(std::move(value));
+}
+
+template <typename T>
+Vector<T>& ShardedVector<T>::LocalShard() {
+    return FindShard().items;
+}
+
+template <typename T>
+size_t ShardedVector<T>::Size() const {
+    std::lock_guard lock(mutex_);
+    size_t size = 0;
+    for (const auto &shard : shards_) {
+        size += shard->items.Size();
+    }
+    return size;
+}
+
+template <typename T>
+void ShardedVector<T>::MergeInto(Vector<T> &out) {
+    std::lock_guard lock(mutex_);
+    size_t total = out.Size();
+    for (const auto &shard : shards_) {
+        total += shard->items.Size();
+    }
+    out.Reserve(total);
+    for (auto &shard : shards_) {
+        out.Append(std::move(shard->items));
+    }
+}
+
+template <typename T>
+void ShardedVector<T>::Clear() noexcept {
+    std::lock_guard lock(mutex_);
+    for (auto &shard : shards_) {
+        shard->items.Clear();
+    }
+}
+
+template <typename T>
+typename ShardedVector<T>::Shard& ShardedVector<T>::FindShard() {
+    // последний использованный шард проверяется без обхода кэша
+    static thread_local CacheEntry last;
+    if (last.id != id_) {
+        last = {id_, &FindShardSlow()};
+    }
+    return *last.shard;
+}
+
+template <typename T>
+typename ShardedVector<T>::Shard& ShardedVector<T>::FindShardSlow() {
+    static thread_local Vector<CacheEntry> cache;
+    for (const auto &entry : cache) {
+        if (entry.id == id_) {
+            return *entry.shard;
+        }
+    }
+
+    Shard *shard = nullptr;
+    {
+        std::lock_guard lock(mutex_);
+        const auto this_thread = std::this_thread::get_id();
+        for (const auto &candidate : shards_) {
+            if (candidate->owner == this_thread) {
+                shard = candidate.get();
+                break;
+            }
+        }
+        if (shard == nullptr) {
+            shard = shards_.EmplaceBack(std::make_unique<Shard>(this_thread)).get();
+        }
+    }
+    // записи разрушенных контейнеров отбрасываются вместе со всем кэшем, а шарды живых
+    // контейнеров при следующем обращении будут найдены заново
+    if (cache.Size() == MAX_CACHED_SHARDS) {
+        cache.Clear();
+    }
+    cache.PushBack({id_, shard});
+    return *shard;
+}
@@ -0,0 +1,329 @@
+#pragma once
+#include "vector.h"
+
+// ---------------------------------- SMALL VECTOR --------------------------------------
+
+// Вектор, хранящий до N элементов во встроенном буфере без обращения к куче.
+// При превышении N элементы переносятся в динамическую память (RawMemory),
+// дальнейший рост определяется политикой Growth
+template <typename T, size_t N, typename Growth = DoublingGrowth>
+class SmallVector {
+    static_assert(N > 0, "SmallVector requires non-zero inline capacity");
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    SmallVector() noexcept = default;
+    explicit SmallVector(size_t size);
+    SmallVector(const SmallVector &other);
+    SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+    SmallVector& operator=(const SmallVector &rhs);
+    SmallVector& operator=(SmallVector &&rhs) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+    ~SmallVector();
+
+    void Swap(SmallVector &other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+    size_t Size() const noexcept;
+    size_t Capacity() const noexcept;
+    // элементы хранятся во встроенном буфере
+    bool IsInline() const noexcept;
+    void Reserve(size_t new_capacity);
+    void Resize(size_t new_size);
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+    T& PushBack(const T &value);
+    T& PushBack(T &&value);
+    void PopBack() noexcept;
+
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args);
+    iterator Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>);
+    iterator Insert(const_iterator pos, const T &value);
+    iterator Insert(const_iterator pos, T &&value);
+
+    const T& operator[](size_t index) const noexcept;
+    T& operator[](size_t index) noexcept;
+
+private:
+    // пока память в куче не выделена, элементы лежат во встроенном буфере
+    alignas(T) unsigned char inline_buffer_[N * sizeof(T)];
+    RawMemory<T> heap_;
+    size_t size_ = 0;
+
+    T* Data() noexcept;
+    const T* Data() const noexcept;
+    // ёмкость, до которой вырастет заполненный вектор
+    size_t GrownCapacity() const noexcept;
+
+    // переносит элементы rhs во встроенный буфер либо забирает его память в куче
+    void MoveFrom(SmallVector &&rhs) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+}; // class SmallVector
+
+template <typename T, size_t N, typename Growth>
+typename SmallVector<T, N, Growth>::iterator SmallVector<T, N, Growth>::begin() noexcept {
+    return Data();
+}
+
+template <typename T, size_t N, typename Growth>
+typename SmallVector<T, N, Growth>::iterator SmallVector<T, N, Growth>::end() noexcept {
+    return Data() + size_;
+}
+
+template <typename T, size_t N, typename Growth>
+typename SmallVector<T, N, Growth>::const_iterator SmallVector<T, N, Growth>::begin() const noexcept {
+    return Data();
+}
+
+template <typename T, size_t N, typename Growth>
+typename SmallVector<T, N, Growth>::const_iterator SmallVector<T, N, Growth>::end() const noexcept {
+    return Data() + size_;
+}
+
+template <typename T, size_t N, typename Growth>
+typename SmallVector<T, N, Growth>::const_iterator SmallVector<T, N, Growth>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename T, size_t N, typename Growth>
+typename SmallVector<T, N, Growth>::const_iterator SmallVector<T, N, Growth>::cend() const noexcept {
+    return end();
+}
+
+template <typename T, size_t N, typename Growth>
+SmallVector<T, N, Growth>::SmallVector(size_t size) {
+    Reserve(size);
+    std::uninitialized_value_construct_n(Data(), size);
+    size_ = size;
+}
+
+template <typename T, size_t N, typename Growth>
+SmallVector<T, N, Growth>::SmallVector(const SmallVector &other) {
+    Reserve(other.size_);
+    std::uninitialized_copy_n(other.Data(), other.size_, Data());
+    size_ = other.size_;
+}
+
+template <typename T, size_t N, typename Growth>
+SmallVector<T, N, Growth>::SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    MoveFrom(std::move(other));
+}
+
+template <typename T, size_t N, typename Growth>
+SmallVector<T, N, Growth>& SmallVector<T, N, Growth>::operator=(const SmallVector &rhs) {
+    if (this != &rhs) {
+        if (rhs.size_ > Capacity()) {
+            SmallVector rhs_copy(rhs);
+            Swap(rhs_copy);
+        } else {
+            size_t copy_elem = rhs.size_ < size_ ? rhs.size_ : size_;
+            auto end = std::copy_n(rhs.Data(), copy_elem, Data());
+            if (rhs.size_ < size_) {
+                std::destroy_n(end, size_ - rhs.size_);
+            } else {
+                std::uninitialized_copy_n(rhs.Data() + size_, rhs.size_ - size_, end);
+            }
+            size_ = rhs.size_;
+        }
+    }
+    return *this;
+}
+
+template <typename T, size_t N, typename Growth>
+SmallVector<T, N, Growth>& SmallVector<T, N, Growth>::operator=(SmallVector &&rhs)
+noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if (this != &rhs) {
+        std::destroy_n(Data(), size_);
+        size_ = 0;
+        MoveFrom(std::move(rhs));
+    }
+    return *this;
+}
+
+template <typename T, size_t N, typename Growth>
+SmallVector<T, N, Growth>::~SmallVector() {
+    std::destroy_n(Data(), size_);
+}
+
+template <typename T, size_t N, typename Growth>
+void SmallVector<T, N, Growth>::Swap(SmallVector &other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if (this == &other) {
+        return;
+    }
+    if (!IsInline() && !other.IsInline()) {
+        heap_.Swap(other.heap_);
+        std::swap(size_, other.size_);
+        return;
+    }
+    SmallVector temp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(temp);
+}
+
+template <typename T, size_t N, typename Growth>
+size_t SmallVector<T, N, Growth>::Size() const noexcept {
+    return size_;
+}
+
+template <typename T, size_t N, typename Growth>
+size_t SmallVector<T, N, Growth>::Capacity() const noexcept {
+    return IsInline() ? N : heap_.Capacity();
+}
+
+template <typename T, size_t N, typename Growth>
+bool SmallVector<T, N, Growth>::IsInline() const noexcept {
+    return heap_.Capacity() == 0;
+}
+
+template <typename T, size_t N, typename Growth>
+void SmallVector<T, N, Growth>::Reserve(size_t new_capacity) {
+    if (new_capacity <= Capacity()) {
+        return;
+    }
+    RawMemory<T> new_data{new_capacity};
+    SafeMove(Data(), size_, new_data.GetAddress());
+    heap_.Swap(new_data);
+}
+
+template <typename T, size_t N, typename Growth>
+void SmallVector<T, N, Growth>::Resize(size_t new_size) {
+    if (new_size < size_) {
+        std::destroy_n(Data() + new_size, size_ - new_size);
+    } else if (new_size > size_) {
+        Reserve(new_size);
+        std::uninitialized_value_construct_n(Data() + size_, new_size - size_);
+    }
+    size_ = new_size;
+}
+
+template <typename T, size_t N, typename Growth>
+T& SmallVector<T, N, Growth>::PushBack(const T &value) {
+    return EmplaceBack(value);
+}
+
+template <typename T, size_t N, typename Growth>
+T& SmallVector<T, N, Growth>::PushBack(T &&value) {
+    return EmplaceBack(std::move(value));
+}
+
+template <typename T, size_t N, typename Growth>
+void SmallVector<T, N, Growth>::PopBack() noexcept {
+    assert(size_ > 0);
+    std::destroy_at(Data() + (size_ - 1));
+    --size_;
+}
+
+template <typename T, size_t N, typename Growth>
+template <typename... Args>
+T& SmallVector<T, N, Growth>::EmplaceBack(Args&&... args) {
+    if (size_ == Capacity()) {
+        RawMemory<T> new_data{GrownCapacity()};
+        // новый элемент создаётся до переноса, т.к. аргументы могут ссылаться на элементы вектора
+        RelocateWithEmplace(Data(), size_, new_data.GetAddress(), size_, std::forward<Args>(args)...);
+        heap_.Swap(new_data);
+    } else {
+        new (Data() + size_) T(std::forward<Args>(args)...);
+    }
+    ++size_;
+    return Data()[size_ - 1];
+}
+
+template <typename T, size_t N, typename Growth>
+template <typename... Args>
+typename SmallVector<T, N, Growth>::iterator SmallVector<T, N, Growth>::Emplace(const_iterator pos, Args&&... args) {
+    assert(pos >= begin() && pos <= end());
+    size_t index = static_cast<size_t>(pos - begin());
+    if (index == size_) {
+        return &EmplaceBack(std::forward<Args>(args)...);
+    }
+    if (size_ == Capacity()) {
+        RawMemory<T> new_data{GrownCapacity()};
+        RelocateWithEmplace(Data(), size_, new_data.GetAddress(), index, std::forward<Args>(args)...);
+        heap_.Swap(new_data);
+    } else {
+        EmplaceShifted(Data(), size_, index, std::forward<Args>(args)...);
+    }
+    ++size_;
+    return begin() + index;
+}
+
+template <typename T, size_t N, typename Growth>
+typename SmallVector<T, N, Growth>::iterator SmallVector<T, N, Growth>::Insert(const_iterator pos, const T &value) {
+    return Emplace(pos, value);
+}
+
+template <typename T, size_t N, typename Growth>
+typename SmallVector<T, N, Growth>::iterator SmallVector<T, N, Growth>::Insert(const_iterator pos, T &&value) {
+    return Emplace(pos, std::move(value));
+}
+
+template <typename T, size_t N, typename Growth>
+typename SmallVector<T, N, Growth>::iterator SmallVector<T, N, Growth>::Erase(const_iterator pos)
+noexcept(std::is_nothrow_move_assignable_v<T>) {
+    assert(size_ > 0);
+    size_t index = static_cast<size_t>(pos - begin());
+    std::move(begin() + index + 1, end(), begin() + index);
+    std::destroy_at(Data() + (size_ - 1));
+    --size_;
+    return begin() + index;
+}
+
+template <typename T, size_t N, typename Growth>
+const T& SmallVector<T, N, Growth>::operator[](size_t index) const noexcept {
+    return const_cast<SmallVector&>(*this)[index];
+}
+
+template <typename T, size_t N, typename Growth>
+T& SmallVector<T, N, Growth>::operator[](size_t index) noexcept {
+    assert(index < size_);
+    return Data()[index];
+}
+
+template <typename T, size_t N, typename Growth>
+T* SmallVector<T, N, Growth>::Data() noexcept {
+    return IsInline() ? std::launder(reinterpret_cast<T*>(inline_buffer_)) : heap_.GetAddress();
+}
+
+template <typename T, size_t N, typename Growth>
+const T* SmallVector<T, N, Growth>::Data() const noexcept {
+    return const_cast<SmallVector&>(*this).Data();
+}
+
+template <typename T, size_t N, typename Growth>
+size_t SmallVector<T, N, Growth>::GrownCapacity() const noexcept {
+    return Growth::NextCapacity(Capacity(), size_ + 1, sizeof(T));
+}
+
+template <typename T, size_t N, typename Growth>
+void SmallVector<T, N, Growth>::MoveFrom(SmallVector &&rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    // вызывается только для пустого вектора
+    assert(size_ == 0);
+    if (rhs.IsInline()) {
+        // ёмкость приёмника не меньше N, поэтому элементы помещаются без реаллокации
+        RelocateElements(rhs.Data(), rhs.size_, Data());
+    } else {
+        heap_ = std::move(rhs.heap_);
+    }
+    size_ = std::exchange(rhs.size_, 0);
+}
+
+template <typename T, size_t N, typename Growth>
+std::ostream& operator<<(std::ostream &out, const SmallVector<T, N, Growth> &vector) {
+    out << "[ ";
+    for (const auto &elem : vector) {
+        out << elem << " ";
+    }
+    out << "]\n";
+    return out;
+}
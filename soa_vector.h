@@ -0,0 +1,369 @@
+#pragma once
+#include "vector.h"
+
+#include <tuple>
+
+// ------------------------------- STRUCTURE OF ARRAYS ----------------------------------
+
+// Вектор записей из полей Fields..., каждое поле которых хранится в собственном столбце RawMemory.
+// Циклы, читающие часть полей, загружают в кэш только нужные столбцы, а Column<I>() отдаёт
+// столбец непрерывным Span для векторизованной обработки. Строка доступна через operator[]
+// как кортеж ссылок на её поля: auto [x, y] = particles[i];
+// При росте сначала выделяется память под все столбцы, затем элементы переносятся за один проход
+template <typename... Fields>
+class SoAVector {
+    static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+
+public:
+    static constexpr size_t COLUMNS = sizeof...(Fields);
+
+    template <size_t I>
+    using Field = std::tuple_element_t<I, std::tuple<Fields...>>;
+    using Row = std::tuple<Fields&...>;
+    using ConstRow = std::tuple<const Fields&...>;
+
+    SoAVector() noexcept = default;
+    explicit SoAVector(size_t size);
+    SoAVector(const SoAVector &other);
+    SoAVector(SoAVector &&other) noexcept;
+
+    SoAVector& operator=(const SoAVector &rhs);
+    SoAVector& operator=(SoAVector &&rhs) noexcept;
+
+    ~SoAVector();
+
+    void Swap(SoAVector &other) noexcept;
+
+    size_t Size() const noexcept;
+    size_t Capacity() const noexcept;
+    void Reserve(size_t new_capacity);
+    void Resize(size_t new_size);
+    void Clear() noexcept;
+    void ShrinkToFit();
+
+    // Добавляет строку, поле I которой создаётся из аргумента I
+    template <typename... Args>
+    Row EmplaceBack(Args&&... args);
+    void PopBack() noexcept;
+    // удаляет строки с индексами [first, last), сдвигая последующие
+    void Erase(size_t index);
+    void Erase(size_t first, size_t last);
+
+    Row operator[](size_t index) noexcept;
+    ConstRow operator[](size_t index) const noexcept;
+
+    // столбец поля I; действителен, пока не изменится ёмкость
+    template <size_t I>
+    Span<Field<I>> Column() noexcept;
+    template <size_t I>
+    Span<const Field<I>> Column() const noexcept;
+
+private:
+    using Columns = std::tuple<RawMemory<Fields>...>;
+    using Indices = std::index_sequence_for<Fields...>;
+
+    // перенос столбца может выбросить исключение: такой столбец копируется до переноса остальных
+    template <typename F>
+    static constexpr bool RELOCATION_MAY_THROW = !IsTriviallyRelocatableV<F>
+                                                 && !std::is_nothrow_move_constructible_v<F>;
+
+    Columns columns_;
+    size_t size_ = 0;
+
+    static Columns AllocateColumns(size_t capacity);
+
+    // Вызывает construct(column, dst) для каждого столбца, где column - std::integral_constant
+    // с номером столбца, а dst - адрес строки first в нём. construct создаёт count элементов
+    // и при исключении сама удаляет созданные ей. При исключении в одном из столбцов элементы,
+    // созданные в предыдущих столбцах, удаляются
+    template <size_t I = 0, typename Construct>
+    static void ConstructColumns(Columns &columns, size_t first, size_t count, Construct &construct);
+    template <size_t... I>
+    static void DestroyColumns(Columns &columns, size_t first, size_t count, std::index_sequence<I...>) noexcept;
+
+    // Переносит все строки в new_columns. При исключении new_columns остаются пустыми,
+    // а строки вектора - нетронутыми
+    void RelocateColumns(Columns &new_columns);
+    template <size_t I = 0>
+    void CopyThrowingColumns(Columns &new_columns);
+    template <size_t... I>
+    void MoveRemainingColumns(Columns &new_columns, std::index_sequence<I...>) noexcept;
+
+    void Reallocate(size_t new_capacity);
+    size_t NextCapacity() const noexcept;
+    void DestroyTail(size_t new_size) noexcept;
+
+}; // class SoAVector
+
+template <typename... Fields>
+SoAVector<Fields...>::SoAVector(size_t size)
+    : columns_(AllocateColumns(size))  //
+{
+    auto construct = [&](auto /*column*/, auto *dst) {
+        std::uninitialized_value_construct_n(dst, size);
+    };
+    ConstructColumns(columns_, 0, size, construct);
+    size_ = size;
+}
+
+template <typename... Fields>
+SoAVector<Fields...>::SoAVector(const SoAVector &other)
+    : columns_(AllocateColumns(other.size_))  //
+{
+    auto construct = [&](auto column, auto *dst) {
+        std::uninitialized_copy_n(std::get<decltype(column)::value>(other.columns_).GetAddress(), other.size_, dst);
+    };
+    ConstructColumns(columns_, 0, other.size_, construct);
+    size_ = other.size_;
+}
+
+template <typename... Fields>
+SoAVector<Fields...>::SoAVector(SoAVector &&other) noexcept
+    : columns_(std::move(other.columns_))
+    , size_(std::exchange(other.size_, 0))  //
+{
+}
+
+template <typename... Fields>
+SoAVector<Fields...>& SoAVector<Fields...>::operator=(const SoAVector &rhs) {
+    if (this != &rhs) {
+        SoAVector rhs_copy(rhs);
+        Swap(rhs_copy);
+    }
+    return *this;
+}
+
+template <typename... Fields>
+SoAVector<Fields...>& SoAVector<Fields...>::operator=(SoAVector &&rhs) noexcept {
+    if (this != &rhs) {
+        DestroyTail(0);
+        columns_ = std::move(rhs.columns_);
+        size_ = std::exchange(rhs.size_, 0);
+    }
+    return *this;
+}
+
+template <typename... Fields>
+SoAVector<Fields...>::~SoAVector() {
+    DestroyTail(0);
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::Swap(SoAVector &other) noexcept {
+    columns_.swap(other.columns_);
+    std::swap(size_, other.size_);
+}
+
+template <typename... Fields>
+size_t SoAVector<Fields...>::Size() const noexcept {
+    return size_;
+}
+
+template <typename... Fields>
+size_t SoAVector<Fields...>::Capacity() const noexcept {
+    return std::get<0>(columns_).Capacity();
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::Reserve(size_t new_capacity) {
+    if (new_capacity > Capacity()) {
+        Reallocate(new_capacity);
+    }
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::Resize(size_t new_size) {
+    if (new_size <= size_) {
+        DestroyTail(new_size);
+        return;
+    }
+    Reserve(new_size);
+    auto construct = [&](auto /*column*/, auto *dst) {
+        std::uninitialized_value_construct_n(dst, new_size - size_);
+    };
+    ConstructColumns(columns_, size_, new_size - size_, construct);
+    size_ = new_size;
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::Clear() noexcept {
+    DestroyTail(0);
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::ShrinkToFit() {
+    if (size_ < Capacity()) {
+        Reallocate(size_);
+    }
+}
+
+template <typename... Fields>
+template <typename... Args>
+typename SoAVector<Fields...>::Row SoAVector<Fields...>::EmplaceBack(Args&&... args) {
+    static_assert(sizeof...(Args) == COLUMNS, "EmplaceBack needs one argument per field");
+    auto values = std::forward_as_tuple(std::forward<Args>(args)...);
+    auto construct = [&](auto column, auto *dst) {
+        constexpr size_t I = decltype(column)::value;
+        new (dst) Field<I>(std::get<I>(std::move(values)));
+    };
+    if (size_ == Capacity()) {
+        // строка создаётся до переноса, так как аргументы могут ссылаться на поля вектора
+        Columns new_columns = AllocateColumns(NextCapacity());
+        ConstructColumns(new_columns, size_, 1, construct);
+        try {
+            RelocateColumns(new_columns);
+        } catch (...) {
+            DestroyColumns(new_columns, size_, 1, Indices{});
+            throw;
+        }
+        columns_.swap(new_columns);
+    } else {
+        ConstructColumns(columns_, size_, 1, construct);
+    }
+    ++size_;
+    return (*this)[size_ - 1];
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::PopBack() noexcept {
+    assert(size_ > 0);
+    DestroyTail(size_ - 1);
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::Erase(size_t index) {
+    Erase(index, index + 1);
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::Erase(size_t first, size_t last) {
+    assert(first <= last && last <= size_);
+    if (first == last) {
+        return;
+    }
+    std::apply([&](auto&... column) {
+        (std::move(column + last, column + size_, column + first), ...);
+    }, columns_);
+    DestroyTail(size_ - (last - first));
+}
+
+template <typename... Fields>
+typename SoAVector<Fields...>::Row SoAVector<Fields...>::operator[](size_t index) noexcept {
+    assert(index < size_);
+    return std::apply([index](auto&... column) {
+        return Row(column[index]...);
+    }, columns_);
+}
+
+template <typename... Fields>
+typename SoAVector<Fields...>::ConstRow SoAVector<Fields...>::operator[](size_t index) const noexcept {
+    assert(index < size_);
+    return std::apply([index](const auto&... column) {
+        return ConstRow(column[index]...);
+    }, columns_);
+}
+
+template <typename... Fields>
+template <size_t I>
+Span<typename SoAVector<Fields...>::template Field<I>> SoAVector<Fields...>::Column() noexcept {
+    return {std::get<I>(columns_).GetAddress(), size_};
+}
+
+template <typename... Fields>
+template <size_t I>
+Span<const typename SoAVector<Fields...>::template Field<I>> SoAVector<Fields...>::Column() const noexcept {
+    return {std::get<I>(columns_).GetAddress(), size_};
+}
+
+template <typename... Fields>
+typename SoAVector<Fields...>::Columns SoAVector<Fields...>::AllocateColumns(size_t capacity) {
+    return Columns(RawMemory<Fields>(capacity)...);
+}
+
+template <typename... Fields>
+template <size_t I, typename Construct>
+void SoAVector<Fields...>::ConstructColumns(Columns &columns, size_t first, size_t count, Construct &construct) {
+    if constexpr (I < COLUMNS) {
+        auto &column = std::get<I>(columns);
+        construct(std::integral_constant<size_t, I>{}, column + first);
+        try {
+            ConstructColumns<I + 1>(columns, first, count, construct);
+        } catch (...) {
+            std::destroy_n(column + first, count);
+            throw;
+        }
+    }
+}
+
+template <typename... Fields>
+template <size_t... I>
+void SoAVector<Fields...>::DestroyColumns(Columns &columns, size_t first, size_t count,
+                                          std::index_sequence<I...>) noexcept {
+    (std::destroy_n(std::get<I>(columns) + first, count), ...);
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::RelocateColumns(Columns &new_columns) {
+    // сначала копируются столбцы, перенос которых может выбросить исключение: пока исходные
+    // строки не тронуты, ошибку можно отменить. Остальные столбцы переносятся без исключений
+    CopyThrowingColumns(new_columns);
+    MoveRemainingColumns(new_columns, Indices{});
+}
+
+template <typename... Fields>
+template <size_t I>
+void SoAVector<Fields...>::CopyThrowingColumns(Columns &new_columns) {
+    if constexpr (I < COLUMNS) {
+        using F = Field<I>;
+        if constexpr (RELOCATION_MAY_THROW<F>) {
+            F *dst = std::get<I>(new_columns).GetAddress();
+            if constexpr (std::is_copy_constructible_v<F>) {
+                std::uninitialized_copy_n(std::get<I>(columns_).GetAddress(), size_, dst);
+            } else {
+                std::uninitialized_move_n(std::get<I>(columns_).GetAddress(), size_, dst);
+            }
+            try {
+                CopyThrowingColumns<I + 1>(new_columns);
+            } catch (...) {
+                std::destroy_n(dst, size_);
+                throw;
+            }
+        } else {
+            CopyThrowingColumns<I + 1>(new_columns);
+        }
+    }
+}
+
+template <typename... Fields>
+template <size_t... I>
+void SoAVector<Fields...>::MoveRemainingColumns(Columns &new_columns, std::index_sequence<I...>) noexcept {
+    auto relocate = [&](auto &from, auto &to) {
+        using F = std::remove_pointer_t<decltype(from.GetAddress())>;
+        vector_stats::OnRelocate<F>(size_);
+        if constexpr (RELOCATION_MAY_THROW<F>) {
+            std::destroy_n(from.GetAddress(), size_);
+        } else {
+            RelocateElements(from.GetAddress(), size_, to.GetAddress());
+        }
+    };
+    (relocate(std::get<I>(columns_), std::get<I>(new_columns)), ...);
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::Reallocate(size_t new_capacity) {
+    Columns new_columns = AllocateColumns(new_capacity);
+    RelocateColumns(new_columns);
+    columns_.swap(new_columns);
+}
+
+template <typename... Fields>
+size_t SoAVector<Fields...>::NextCapacity() const noexcept {
+    return DoublingGrowth::NextCapacity(Capacity(), size_ + 1, 0);
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::DestroyTail(size_t new_size) noexcept {
+    assert(new_size <= size_);
+    DestroyColumns(columns_, new_size, size_ - new_size, Indices{});
+    size_ = new_size;
+}
@@ -0,0 +1,378 @@
+#pragma once
+#include "vector.h"
+
+#include <stdexcept>
+
+// --------------------------------- STATIC VECTOR --------------------------------------
+
+namespace {
+
+// Хранилище StaticVector. Элементы тривиальных типов хранятся в обычном массиве: все операции
+// над ними выполняются присваиванием и доступны в constexpr, а деструктор остаётся тривиальным.
+// Остальные элементы создаются размещающим new в выровненном буфере и удаляются деструктором
+template <typename T, size_t N, bool TRIVIAL = std::is_trivial_v<T>>
+class StaticVectorStorage;
+
+template <typename T, size_t N>
+class StaticVectorStorage<T, N, true> {
+public:
+    constexpr T* Data() noexcept {
+        return items_;
+    }
+    constexpr const T* Data() const noexcept {
+        return items_;
+    }
+
+    size_t size_ = 0;
+
+private:
+    // в C++17 constexpr-конструктор обязан инициализировать массив
+    T items_[N == 0 ? 1 : N] = {};
+};
+
+template <typename T, size_t N>
+class StaticVectorStorage<T, N, false> {
+public:
+    StaticVectorStorage() noexcept {}
+    StaticVectorStorage(const StaticVectorStorage&) = delete;
+    StaticVectorStorage& operator=(const StaticVectorStorage&) = delete;
+    ~StaticVectorStorage() {
+        std::destroy_n(Data(), size_);
+    }
+
+    T* Data() noexcept {
+        return std::launder(reinterpret_cast<T*>(bytes_));
+    }
+    const T* Data() const noexcept {
+        return std::launder(reinterpret_cast<const T*>(bytes_));
+    }
+
+    size_t size_ = 0;
+
+private:
+    alignas(T) unsigned char bytes_[sizeof(T) * (N == 0 ? 1 : N)];
+};
+
+} // namespace
+
+// Вектор ёмкостью не более N элементов, хранящихся внутри объекта: память никогда не выделяется
+// из кучи. Интерфейс повторяет Vector<T>; при превышении ёмкости EmplaceBack, Insert и Resize
+// выбрасывают std::length_error, а TryEmplaceBack возвращает nullptr.
+// Для тривиальных типов (std::is_trivial_v<T>) все методы доступны в constexpr
+template <typename T, size_t N>
+class StaticVector {
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    constexpr iterator begin() noexcept;
+    constexpr iterator end() noexcept;
+    constexpr const_iterator begin() const noexcept;
+    constexpr const_iterator end() const noexcept;
+    constexpr const_iterator cbegin() const noexcept;
+    constexpr const_iterator cend() const noexcept;
+
+    constexpr StaticVector() noexcept = default;
+    constexpr explicit StaticVector(size_t size);
+    constexpr StaticVector(std::initializer_list<T> init);
+    constexpr StaticVector(const StaticVector &other);
+    constexpr StaticVector(StaticVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+    constexpr StaticVector& operator=(const StaticVector &rhs);
+    constexpr StaticVector& operator=(StaticVector &&rhs) noexcept(std::is_nothrow_move_assignable_v<T>
+                                                                   && std::is_nothrow_move_constructible_v<T>);
+
+    constexpr size_t Size() const noexcept;
+    static constexpr size_t Capacity() noexcept;
+    constexpr void Resize(size_t new_size);
+    constexpr void Clear() noexcept;
+
+    template <typename... Args>
+    constexpr T& EmplaceBack(Args&&... args);
+    // Создаёт элемент в конце, если есть место, иначе возвращает nullptr без создания элемента
+    template <typename... Args>
+    constexpr T* TryEmplaceBack(Args&&... args);
+    constexpr T& PushBack(const T &value);
+    constexpr T& PushBack(T &&value);
+    constexpr void PopBack() noexcept;
+
+    template <typename... Args>
+    constexpr iterator Emplace(const_iterator pos, Args&&... args);
+    constexpr iterator Insert(const_iterator pos, const T &value);
+    constexpr iterator Insert(const_iterator pos, T &&value);
+    constexpr iterator Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>);
+    constexpr iterator Erase(const_iterator first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+    constexpr const T& operator[](size_t index) const noexcept;
+    constexpr T& operator[](size_t index) noexcept;
+
+private:
+    static constexpr bool TRIVIAL = std::is_trivial_v<T>;
+
+    StaticVectorStorage<T, N> storage_;
+
+    // создаёт элемент в неинициализированной позиции index
+    template <typename... Args>
+    constexpr T& ConstructAt(size_t index, Args&&... args);
+    constexpr void DestroyTail(size_t new_size) noexcept;
+    static void ThrowLengthError();
+
+}; // class StaticVector
+
+template <typename T, size_t N>
+constexpr typename StaticVector<T, N>::iterator StaticVector<T, N>::begin() noexcept {
+    return storage_.Data();
+}
+
+template <typename T, size_t N>
+constexpr typename StaticVector<T, N>::iterator StaticVector<T, N>::end() noexcept {
+    return storage_.Data() + storage_.size_;
+}
+
+template <typename T, size_t N>
+constexpr typename StaticVector<T, N>::const_iterator StaticVector<T, N>::begin() const noexcept {
+    return storage_.Data();
+}
+
+template <typename T, size_t N>
+constexpr typename StaticVector<T, N>::const_iterator StaticVector<T, N>::end() const noexcept {
+    return storage_.Data() + storage_.size_;
+}
+
+template <typename T, size_t N>
+constexpr typename StaticVector<T, N>::const_iterator StaticVector<T, N>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename T, size_t N>
+constexpr typename StaticVector<T, N>::const_iterator StaticVector<T, N>::cend() const noexcept {
+    return end();
+}
+
+// При исключении в конструкторах хранилище удаляет уже созданные элементы
+template <typename T, size_t N>
+constexpr StaticVector<T, N>::StaticVector(size_t size) {
+    Resize(size);
+}
+
+template <typename T, size_t N>
+constexpr StaticVector<T, N>::StaticVector(std::initializer_list<T> init) {
+    if (init.size() > N) {
+        ThrowLengthError();
+    }
+    for (const T &value : init) {
+        ConstructAt(storage_.size_, value);
+        ++storage_.size_;
+    }
+}
+
+template <typename T, size_t N>
+constexpr StaticVector<T, N>::StaticVector(const StaticVector &other) {
+    for (const T &value : other) {
+        ConstructAt(storage_.size_, value);
+        ++storage_.size_;
+    }
+}
+
+template <typename T, size_t N>
+constexpr StaticVector<T, N>::StaticVector(StaticVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    for (T &value : other) {
+        ConstructAt(storage_.size_, std::move(value));
+        ++storage_.size_;
+    }
+}
+
+template <typename T, size_t N>
+constexpr StaticVector<T, N>& StaticVector<T, N>::operator=(const StaticVector &rhs) {
+    if (this != &rhs) {
+        // общая часть присваивается, лишние элементы удаляются, недостающие создаются
+        const size_t common = std::min(storage_.size_, rhs.storage_.size_);
+        for (size_t i = 0; i < common; ++i) {
+            (*this)[i] = rhs[i];
+        }
+        DestroyTail(common);
+        while (storage_.size_ < rhs.storage_.size_) {
+            ConstructAt(storage_.size_, rhs[storage_.size_]);
+            ++storage_.size_;
+        }
+    }
+    return *this;
+}
+
+template <typename T, size_t N>
+constexpr StaticVector<T, N>& StaticVector<T, N>::operator=(StaticVector &&rhs) noexcept(
+    std::is_nothrow_move_assignable_v<T> && std::is_nothrow_move_constructible_v<T>) {
+    if (this != &rhs) {
+        const size_t common = std::min(storage_.size_, rhs.storage_.size_);
+        for (size_t i = 0; i < common; ++i) {
+            (*this)[i] = std::move(rhs[i]);
+        }
+        DestroyTail(common);
+        while (storage_.size_ < rhs.storage_.size_) {
+            ConstructAt(storage_.size_, std::move(rhs[storage_.size_]));
+            ++storage_.size_;
+        }
+    }
+    return *this;
+}
+
+template <typename T, size_t N>
+constexpr size_t StaticVector<T, N>::Size() const noexcept {
+    return storage_.size_;
+}
+
+template <typename T, size_t N>
+constexpr size_t StaticVector<T, N>::Capacity() noexcept {
+    return N;
+}
+
+template <typename T, size_t N>
+constexpr void StaticVector<T, N>::Resize(size_t new_size) {
+    if (new_size > N) {
+        ThrowLengthError();
+    }
+    if (new_size < storage_.size_) {
+        DestroyTail(new_size);
+    }
+    while (storage_.size_ < new_size) {
+        ConstructAt(storage_.size_);
+        ++storage_.size_;
+    }
+}
+
+template <typename T, size_t N>
+constexpr void StaticVector<T, N>::Clear() noexcept {
+    DestroyTail(0);
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+constexpr T& StaticVector<T, N>::EmplaceBack(Args&&... args) {
+    T *elem = TryEmplaceBack(std::forward<Args>(args)...);
+    if (elem == nullptr) {
+        ThrowLengthError();
+    }
+    return *elem;
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+constexpr T* StaticVector<T, N>::TryEmplaceBack(Args&&... args) {
+    if (storage_.size_ == N) {
+        return nullptr;
+    }
+    T &elem = ConstructAt(storage_.size_, std::forward<Args>(args)...);
+    ++storage_.size_;
+    return &elem;
+}
+
+template <typename T, size_t N>
+constexpr T& StaticVector<T, N>::PushBack(const T &value) {
+    return EmplaceBack(value);
+}
+
+template <typename T, size_t N>
+constexpr T& StaticVector<T, N>::PushBack(T &&value) {
+    return EmplaceBack(std::move(value));
+}
+
+template <typename T, size_t N>
+constexpr void StaticVector<T, N>::PopBack() noexcept {
+    assert(storage_.size_ > 0);
+    DestroyTail(storage_.size_ - 1);
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+constexpr typename StaticVector<T, N>::iterator StaticVector<T, N>::Emplace(const_iterator pos, Args&&... args) {
+    assert(pos >= cbegin() && pos <= cend());
+    const size_t index = static_cast<size_t>(pos - cbegin());
+    if (storage_.size_ == N) {
+        ThrowLengthError();
+    }
+    if (index == storage_.size_) {
+        ConstructAt(index, std::forward<Args>(args)...);
+    } else if constexpr (TRIVIAL) {
+        // значение вычисляется до сдвига, так как args может ссылаться на сдвигаемые элементы
+        const T value(std::forward<Args>(args)...);
+        for (size_t i = storage_.size_; i > index; --i) {
+            storage_.Data()[i] = storage_.Data()[i - 1];
+        }
+        storage_.Data()[index] = value;
+    } else {
+        // та же схема со строгой гарантией, что и у Vector::EmplaceWithoutReallocate
+        EmplaceShifted(storage_.Data(), storage_.size_, index, std::forward<Args>(args)...);
+    }
+    ++storage_.size_;
+    return begin() + index;
+}
+
+template <typename T, size_t N>
+constexpr typename StaticVector<T, N>::iterator StaticVector<T, N>::Insert(const_iterator pos, const T &value) {
+    return Emplace(pos, value);
+}
+
+template <typename T, size_t N>
+constexpr typename StaticVector<T, N>::iterator StaticVector<T, N>::Insert(const_iterator pos, T &&value) {
+    return Emplace(pos, std::move(value));
+}
+
+template <typename T, size_t N>
+constexpr typename StaticVector<T, N>::iterator
+StaticVector<T, N>::Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    return Erase(pos, pos + 1);
+}
+
+template <typename T, size_t N>
+constexpr typename StaticVector<T, N>::iterator
+StaticVector<T, N>::Erase(const_iterator first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    assert(cbegin() <= first && first <= last && last <= cend());
+    const size_t index = static_cast<size_t>(first - cbegin());
+    const size_t count = static_cast<size_t>(last - first);
+    if (count > 0) {
+        for (size_t i = index; i + count < storage_.size_; ++i) {
+            storage_.Data()[i] = std::move(storage_.Data()[i + count]);
+        }
+        DestroyTail(storage_.size_ - count);
+    }
+    return begin() + index;
+}
+
+template <typename T, size_t N>
+constexpr const T& StaticVector<T, N>::operator[](size_t index) const noexcept {
+    assert(index < storage_.size_);
+    return storage_.Data()[index];
+}
+
+template <typename T, size_t N>
+constexpr T& StaticVector<T, N>::operator[](size_t index) noexcept {
+    assert(index < storage_.size_);
+    return storage_.Data()[index];
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+constexpr T& StaticVector<T, N>::ConstructAt(size_t index, Args&&... args) {
+    if constexpr (TRIVIAL) {
+        // элементы тривиального массива уже созданы, поэтому достаточно присваивания
+        storage_.Data()[index] = T(std::forward<Args>(args)...);
+        return storage_.Data()[index];
+    } else {
+        return *new (storage_.Data() + index) T(std::forward<Args>(args)...);
+    }
+}
+
+template <typename T, size_t N>
+constexpr void StaticVector<T, N>::DestroyTail(size_t new_size) noexcept {
+    assert(new_size <= storage_.size_);
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        std::destroy(storage_.Data() + new_size, storage_.Data() + storage_.size_);
+    }
+    storage_.size_ = new_size;
+}
+
+template <typename T, size_t N>
+void StaticVector<T, N>::ThrowLengthError() {
+    throw std::length_error("StaticVector capacity exceeded");
+}
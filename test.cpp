@@ -1,8 +1,34 @@
 #include "vector.h"
+#include "buffer_pool.h"
+#include "small_vector.h"
+#include "concurrent_vector.h"
+#include "sharded_vector.h"
+#include "segmented_vector.h"
+#include "mapped_vector.h"
+#include "vector_io.h"
+#include "soa_vector.h"
+#include "cow_vector.h"
+#include "flat_map.h"
+#include "ring_vector.h"
+#include "static_vector.h"
+#include "hinted_vector.h"
+#include "vector_algorithms.h"
 
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <map>
+#include <memory_resource>
+#include <numeric>
+#include <set>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -558,84 +584,2223 @@ void Test6() {
     }
 }
 
-struct C {
-    C() noexcept {
-        ++def_ctor;
+void Test7() {
+    static_assert(IsTriviallyRelocatableV<int>);
+    static_assert(IsTriviallyRelocatableV<std::unique_ptr<int>>);
+    static_assert(!IsTriviallyRelocatableV<std::string>);
+    static_assert(!IsTriviallyRelocatableV<Obj>);
+    const int SIZE = 1000;
+    {
+        Vector<std::unique_ptr<int>> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(std::make_unique<int>(i));
+        }
+        v.Reserve(SIZE * 4);
+        assert(v.Size() == SIZE);
+        assert(v.Capacity() == SIZE * 4);
+        for (int i = 0; i < SIZE; ++i) {
+            assert(*v[static_cast<size_t>(i)] == i);
+        }
     }
-    C(const C& /*other*/) noexcept {
-        ++copy_ctor;
+    {
+        Vector<std::unique_ptr<int>> v;
+        v.EmplaceBack(std::make_unique<int>(1));
+        v.EmplaceBack(std::make_unique<int>(3));
+        assert(v.Size() == v.Capacity());
+        // вставка с реаллокацией переносит элементы побайтово
+        v.Emplace(v.cbegin() + 1, std::make_unique<int>(2));
+        assert(v.Size() == 3);
+        assert(*v[0] == 1 && *v[1] == 2 && *v[2] == 3);
     }
-    C(C&& /*other*/) noexcept {
-        ++move_ctor;
+}
+
+void Test8() {
+    static_assert(RawMemory<int>::REALLOCATABLE);
+    static_assert(!RawMemory<std::string>::REALLOCATABLE);
+    const size_t SIZE = 100'000;
+    {
+        Vector<int> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        v.Reserve(SIZE * 8);
+        assert(v.Capacity() == SIZE * 8);
+        for (size_t i = 0; i < SIZE; ++i) {
+            assert(v[i] == static_cast<int>(i));
+        }
     }
-    C& operator=(const C& other) noexcept {
-        if (this != &other) {
-            ++copy_assign;
+    {
+        Vector<int> v(1);
+        v[0] = 42;
+        assert(v.Size() == v.Capacity());
+        // элемент-аргумент должен пережить реаллокацию буфера
+        v.PushBack(v[0]);
+        v.Insert(v.cbegin(), v[1]);
+        assert(v.Size() == 3);
+        v.Insert(v.cbegin() + 1, 7);
+        assert(v.Size() == 4);
+        assert(v[0] == 42 && v[1] == 7 && v[2] == 42 && v[3] == 42);
+    }
+}
+
+void Test9() {
+    const size_t SIZE = 100;
+    std::byte buffer[4096];
+    const auto in_buffer = [&buffer](const void* ptr) {
+        return ptr >= static_cast<const void*>(buffer) && ptr < static_cast<const void*>(buffer + sizeof(buffer));
+    };
+    {
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+        pmr::Vector<int> v(&arena);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        assert(v.Size() == SIZE);
+        assert(in_buffer(&v[0]));
+        assert(v.GetAllocator().resource() == &arena);
+
+        // при копировании используется select_on_container_copy_construction - ресурс по умолчанию
+        pmr::Vector<int> v_copy(v);
+        assert(!in_buffer(&v_copy[0]));
+        assert(v_copy.GetAllocator().resource() == std::pmr::get_default_resource());
+
+        // polymorphic_allocator не распространяется при присваивании, поэтому элементы
+        // поштучно переносятся в память приёмника
+        v_copy[0] = 42;
+        v = std::move(v_copy);
+        assert(v.Size() == SIZE);
+        assert(v[0] == 42);
+        assert(in_buffer(&v[0]));
+        assert(v.GetAllocator().resource() == &arena);
+
+        pmr::Vector<int> v_other(&arena);
+        v_other.PushBack(1);
+        v.Swap(v_other);
+        assert(v.Size() == 1 && v_other.Size() == SIZE);
+    }
+    {
+        Obj::ResetCounters();
+        std::pmr::monotonic_buffer_resource arena;
+        {
+            pmr::Vector<Obj> v(SIZE, &arena);
+            v.EmplaceBack(1, "Ivan");
+            pmr::Vector<Obj> v_local(&arena);
+            v_local = v;
+            assert(v_local.Size() == SIZE + 1);
+            assert(v_local[SIZE].id == 1);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void Test10() {
+    using namespace std::literals;
+    const size_t INLINE = 4;
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, INLINE> v;
+        assert(v.Capacity() == INLINE);
+        assert(v.IsInline());
+        for (int i = 0; i < static_cast<int>(INLINE); ++i) {
+            v.EmplaceBack(i);
+        }
+        assert(v.IsInline());
+        assert(v.Size() == INLINE);
+        const auto* inline_data = &v[0];
+        v.EmplaceBack(static_cast<int>(INLINE), "Ivan"s);
+        assert(!v.IsInline());
+        assert(&v[0] != inline_data);
+        assert(v.Capacity() == INLINE * 2);
+        assert(v[INLINE].name == "Ivan"s);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(v[i].id == static_cast<int>(i));
+        }
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(INLINE + 1));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        SmallVector<TestObj, INLINE> v(INLINE);
+        assert(v.Size() == v.Capacity());
+        // добавление существующего элемента должно быть безопасно при переносе в кучу
+        v.PushBack(v[0]);
+        v.Insert(v.cbegin() + 1, v[0]);
+        assert(std::all_of(v.begin(), v.end(), [](const TestObj& obj) {
+            return obj.IsAlive();
+        }));
+    }
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, INLINE> v;
+        v.EmplaceBack(1);
+        v.EmplaceBack(3);
+        v.Emplace(v.cbegin() + 1, 2);
+        v.Insert(v.cbegin(), Obj{0});
+        assert(v.Size() == INLINE && v.IsInline());
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(v[i].id == static_cast<int>(i));
+        }
+        v.Emplace(v.cbegin() + 2, 42);
+        assert(!v.IsInline());
+        assert(v[2].id == 42 && v[4].id == 3);
+        v.Erase(v.cbegin() + 2);
+        assert(v.Size() == INLINE);
+        v.Resize(2);
+        assert(v.Size() == 2 && v[1].id == 1);
+        v.Resize(INLINE * 4);
+        assert(v.Size() == INLINE * 4 && v[INLINE * 4 - 1].id == 0);
+        v.PopBack();
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(INLINE * 4 - 1));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, INLINE> small(2);
+        SmallVector<Obj, INLINE> large(INLINE * 2);
+        small[0].id = 1;
+        large[0].id = 2;
+
+        SmallVector<Obj, INLINE> small_copy(small);
+        SmallVector<Obj, INLINE> large_copy(large);
+        assert(small_copy.IsInline() && small_copy[0].id == 1);
+        assert(!large_copy.IsInline() && large_copy[0].id == 2);
+
+        small.Swap(large);
+        assert(small.Size() == INLINE * 2 && small[0].id == 2);
+        assert(large.Size() == 2 && large[0].id == 1);
+
+        SmallVector<Obj, INLINE> moved(std::move(small));
+        assert(moved.Size() == INLINE * 2 && small.Size() == 0);
+        moved = std::move(large);
+        assert(moved.Size() == 2 && moved[0].id == 1);
+        moved = large_copy;
+        assert(moved.Size() == INLINE * 2 && moved[0].id == 2);
+        small = moved;
+        assert(small.Size() == INLINE * 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test11() {
+    {
+        assert(DoublingGrowth::NextCapacity(0, 1, sizeof(int)) == 1);
+        assert(DoublingGrowth::NextCapacity(8, 9, sizeof(int)) == 16);
+        assert(OneAndHalfGrowth::NextCapacity(0, 1, sizeof(int)) == 1);
+        assert(OneAndHalfGrowth::NextCapacity(1, 2, sizeof(int)) == 2);
+        assert(OneAndHalfGrowth::NextCapacity(100, 101, sizeof(int)) == 150);
+        assert(CacheLineGrowth<>::NextCapacity(0, 1, sizeof(int)) == CACHE_LINE_SIZE / sizeof(int));
+        assert(CacheLineGrowth<>::NextCapacity(0, 1, 2 * CACHE_LINE_SIZE) == 1);
+        assert(CacheLineGrowth<>::NextCapacity(16, 17, sizeof(int)) == 32);
+
+        assert(RoundUpToSizeClass(1) == 16);
+        assert(RoundUpToSizeClass(17) == 32);
+        assert(RoundUpToSizeClass(33) == 48);
+        assert(RoundUpToSizeClass(129) == 160);
+        assert(RoundUpToSizeClass(4096) == 4096);
+        assert(RoundUpToSizeClass(4097) == 5120);
+        assert(SizeClassGrowth<>::NextCapacity(0, 1, sizeof(int)) == 4);
+        assert(SizeClassGrowth<OneAndHalfGrowth>::NextCapacity(100, 101, 1) == 160);
+    }
+    {
+        Vector<int, std::allocator<int>, OneAndHalfGrowth> v;
+        size_t reallocations = 0;
+        size_t capacity = v.Capacity();
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(i);
+            if (v.Capacity() != capacity) {
+                assert(capacity == 0 || v.Capacity() == std::max(capacity + 1, capacity + capacity / 2));
+                capacity = v.Capacity();
+                ++reallocations;
+            }
+        }
+        assert(v.Size() == 1000);
+        assert(v[999] == 999);
+        assert(reallocations > 10);
+    }
+    {
+        Vector<Obj, std::allocator<Obj>, CacheLineGrowth<>> v;
+        v.EmplaceBack(1);
+        assert(v.Capacity() == std::max(size_t{1}, CACHE_LINE_SIZE / sizeof(Obj)));
+        v.Emplace(v.cbegin(), 0);
+        assert(v[0].id == 0 && v[1].id == 1);
+    }
+    {
+        Vector<char, std::allocator<char>, CacheLineGrowth<SizeClassGrowth<>>> v;
+        v.PushBack('a');
+        // ёмкость не меньше кэш-линии и может быть увеличена до фактического размера блока
+        assert(v.Capacity() >= CACHE_LINE_SIZE);
+        const size_t capacity = v.Capacity();
+        for (size_t i = 1; i < capacity; ++i) {
+            v.PushBack('b');
+        }
+        assert(v.Capacity() == capacity);
+    }
+    {
+        SmallVector<int, 2, OneAndHalfGrowth> v;
+        v.PushBack(1);
+        v.PushBack(2);
+        v.PushBack(3);
+        assert(v.Capacity() == 3);
+    }
+}
+
+namespace {
+
+// элемент, копирующее присваивание которого выбрасывает исключение для помеченного источника
+struct ThrowingAssign {
+    ThrowingAssign(int value, bool throw_on_assign = false) noexcept
+        : value(value)
+        , throw_on_assign(throw_on_assign) {
+        ++alive;
+    }
+    ThrowingAssign(const ThrowingAssign &other) noexcept
+        : value(other.value)
+        , throw_on_assign(other.throw_on_assign) {
+        ++alive;
+    }
+    ThrowingAssign(ThrowingAssign &&other) noexcept
+        : ThrowingAssign(other) {
+    }
+    ThrowingAssign& operator=(const ThrowingAssign &other) {
+        if (other.throw_on_assign) {
+            throw std::runtime_error("Oops");
         }
+        value = other.value;
         return *this;
     }
-    C& operator=(C&& /*other*/) noexcept {
-        ++move_assign;
+    ThrowingAssign& operator=(ThrowingAssign &&other) noexcept {
+        value = other.value;
+        throw_on_assign = other.throw_on_assign;
         return *this;
     }
-    ~C() {
-        ++dtor;
+    ~ThrowingAssign() {
+        --alive;
     }
 
-    static void Reset() {
-        def_ctor = 0;
-        copy_ctor = 0;
-        move_ctor = 0;
-        copy_assign = 0;
-        move_assign = 0;
-        dtor = 0;
-    }
-
-    inline static size_t def_ctor = 0;
-    inline static size_t copy_ctor = 0;
-    inline static size_t move_ctor = 0;
-    inline static size_t copy_assign = 0;
-    inline static size_t move_assign = 0;
-    inline static size_t dtor = 0;
+    int value;
+    bool throw_on_assign;
+    static inline int alive = 0;
 };
 
-void Dump() {
-    using namespace std;
-    cerr << "Def ctors: "sv << C::def_ctor              //
-         << ", Copy ctors: "sv << C::copy_ctor          //
-         << ", Move ctors: "sv << C::move_ctor          //
-         << ", Copy assignments: "sv << C::copy_assign  //
-         << ", Move assignments: "sv << C::move_assign  //
-         << ", Dtors: "sv << C::dtor << endl;
+}  // namespace
+
+void Test12() {
+    using namespace std::literals;
+    {
+        Vector<int> v{1, 2, 3};
+        assert(v.Size() == 3 && v.Capacity() == 3);
+        assert(v[0] == 1 && v[2] == 3);
+        v.Insert(v.cbegin() + 1, {10, 11});
+        assert(v.Size() == 5);
+        assert(v[0] == 1 && v[1] == 10 && v[2] == 11 && v[3] == 2 && v[4] == 3);
+        v.Reserve(100);
+        // вставка без реаллокации, хвост длиннее и короче вставляемого диапазона
+        const std::vector<int> src{20, 21};
+        v.Insert(v.cbegin(), src.begin(), src.end());
+        assert(v.Size() == 7 && v[0] == 20 && v[1] == 21 && v[2] == 1 && v[6] == 3);
+        const std::vector<int> long_src{30, 31, 32, 33};
+        v.Insert(v.cbegin() + 6, long_src.begin(), long_src.end());
+        assert(v.Size() == 11 && v[6] == 30 && v[9] == 33 && v[10] == 3);
+        assert(v.Capacity() == 100);
+        v.Insert(v.cbegin() + 1, 3, v[0]);
+        assert(v.Size() == 14 && v[1] == 20 && v[3] == 20 && v[4] == 21);
+    }
+    {
+        Vector<std::string> v{"a"s, "b"s, "c"s, "d"s};
+        v.Reserve(16);
+        const std::vector<std::string> one{"x"s};
+        const std::vector<std::string> many{"1"s, "2"s, "3"s, "4"s, "5"s};
+        v.Insert(v.cbegin() + 1, one.begin(), one.end());
+        v.Insert(v.cbegin() + 4, many.begin(), many.end());
+        const std::vector<std::string> expected{"a"s, "x"s, "b"s, "c"s, "1"s, "2"s, "3"s, "4"s, "5"s, "d"s};
+        assert(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+        v.Insert(v.cend(), 2, "z"s);
+        v.Insert(v.cbegin(), 20, "y"s);
+        assert(v.Size() == expected.size() + 22);
+        assert(v[0] == "y"s && v[20] == "a"s && v[v.Size() - 1] == "z"s);
+    }
+    {
+        Obj::ResetCounters();
+        std::vector<Obj> src(5);
+        Vector<Obj> v(10);
+        Obj::ResetCounters();
+        v.Insert(v.cbegin() + 3, src.begin(), src.end());
+        // одна реаллокация: только копирование вставляемых и перемещение старых элементов
+        assert(v.Size() == 15 && v.Capacity() == 20);
+        assert(Obj::num_copied == 5);
+        assert(Obj::num_moved == 10);
+        assert(Obj::num_assigned == 0 && Obj::num_move_assigned == 0);
+        v.Append(src);
+        assert(v.Size() == 20 && v.Capacity() == 20);
+        assert(Obj::num_copied == 10);
+        assert(Obj::num_moved == 10);
+    }
+    {
+        Vector<int> v{1, 5};
+        std::istringstream input("2 3 4");
+        v.Insert(v.cbegin() + 1, std::istream_iterator<int>(input), std::istream_iterator<int>());
+        assert(v.Size() == 5);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(v[i] == static_cast<int>(i + 1));
+        }
+        v.Append(std::vector<int>{6, 7});
+        assert(v.Size() == 7 && v[6] == 7);
+        auto pos = v.Insert(v.cbegin() + 2, 0, 42);
+        assert(pos == v.begin() + 2 && v.Size() == 7);
+    }
+    {
+        // исключение присваивания при вставке без реаллокации (хвост длиннее и короче вставляемого
+        // диапазона): созданные за концом массива элементы удаляются, размер не меняется
+        const std::vector<ThrowingAssign> src{{1, true}, {2}, {3}};
+        for (size_t index : {size_t{1}, size_t{4}}) {
+            Vector<ThrowingAssign> v;
+            v.Reserve(16);
+            for (int i = 0; i < 5; ++i) {
+                v.EmplaceBack(i);
+            }
+            try {
+                v.Insert(v.begin() + index, src.begin(), src.end());
+                assert(false);
+            } catch (const std::runtime_error&) {
+            }
+            assert(v.Size() == 5);
+            assert(ThrowingAssign::alive == static_cast<int>(src.size() + v.Size()));
+        }
+        assert(ThrowingAssign::alive == static_cast<int>(src.size()));
+    }
 }
 
-void Benchmark() {
-    using namespace std;
-    try {
-        const size_t NUM = 10;
-        C c;
+void Test13() {
+    const size_t SIZE = 10;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i].id = static_cast<int>(i);
+        }
+        Obj::ResetCounters();
+        auto pos = v.Erase(v.cbegin() + 2, v.cbegin() + 5);
+        assert(pos == v.begin() + 2);
+        assert(v.Size() == SIZE - 3 && v.Capacity() == SIZE);
+        assert(v[1].id == 1 && v[2].id == 5 && v[6].id == 9);
+        assert(Obj::num_move_assigned == SIZE - 5);
+        assert(Obj::num_destroyed == 3);
+        pos = v.Erase(v.cbegin() + 1, v.cbegin() + 1);
+        assert(pos == v.begin() + 1 && v.Size() == SIZE - 3);
+        v.Erase(v.cbegin(), v.cend());
+        assert(v.Size() == 0);
+        assert(Obj::GetAliveObjectCount() == -static_cast<int>(SIZE));
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i].id = static_cast<int>(i);
+        }
+        Obj::ResetCounters();
+        const size_t removed = v.EraseIf([](const Obj& obj) {
+            return obj.id % 3 == 0;
+        });
+        assert(removed == 4);
+        assert(v.Size() == SIZE - 4);
+        assert(v[0].id == 1 && v[1].id == 2 && v[2].id == 4 && v[5].id == 8);
+        // каждый оставшийся элемент перемещён не более одного раза
+        assert(Obj::num_move_assigned <= static_cast<int>(SIZE - 4));
+        assert(Obj::num_destroyed == 4);
+    }
+    {
+        Vector<int> v{1, 2, 1, 3, 1, 4};
+        assert(v.EraseValue(v[0]) == 3);
+        assert(v.Size() == 3 && v[0] == 2 && v[1] == 3 && v[2] == 4);
+        assert(v.EraseValue(42) == 0);
+        assert(v.Size() == 3);
+    }
+    {
+        Vector<std::unique_ptr<int>> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.EmplaceBack(std::make_unique<int>(i));
+        }
+        v.Erase(v.cbegin() + 1, v.cbegin() + 3);
+        assert(v.Size() == SIZE - 2 && *v[0] == 0 && *v[1] == 3);
+        v.Erase(v.cbegin());
+        assert(*v[0] == 3);
+        assert(v.EraseIf([](const std::unique_ptr<int>& ptr) {
+            return *ptr > 5;
+        }) == 4);
+        assert(v.Size() == 3 && *v[2] == 5);
+    }
+}
+
+void Test14() {
+    const size_t SIZE = 100;
+    {
+        Vector<int> v(SIZE, default_init);
+        assert(v.Size() == SIZE && v.Capacity() == SIZE);
+        std::fill(v.begin(), v.end(), 7);
+        v.ResizeForOverwrite(SIZE * 2);
+        assert(v.Size() == SIZE * 2);
+        assert(v[SIZE - 1] == 7);
+        v.ResizeForOverwrite(1);
+        assert(v.Size() == 1 && v[0] == 7);
+    }
+    {
+        Vector<char> v;
+        const std::string_view message = "hello, world";
+        // имитация чтения из сокета: записывается меньше, чем выделено
+        v.ResizeAndOverwrite(1024, [&message](char* data, size_t count) {
+            assert(count == 1024);
+            std::copy(message.begin(), message.end(), data);
+            return message.size();
+        });
+        assert(v.Size() == message.size() && v.Capacity() == 1024);
+        assert(std::string_view(v.begin(), v.Size()) == message);
+        v.ResizeAndOverwrite(5, [](char* data, size_t /*count*/) {
+            data[0] = 'H';
+            return 5;
+        });
+        assert(std::string_view(v.begin(), v.Size()) == "Hello");
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE, default_init);
+        assert(Obj::num_default_constructed == SIZE);
+        v.ResizeAndOverwrite(SIZE * 2, [](Obj* data, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                data[i].id = static_cast<int>(i);
+            }
+            return SIZE + 1;
+        });
+        assert(v.Size() == SIZE + 1 && v[SIZE].id == static_cast<int>(SIZE));
+        assert(Obj::num_default_constructed == SIZE * 2);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE + 1));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test15() {
+    const size_t SIZE = 100;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v.Clear();
+        assert(v.Size() == 0 && v.Capacity() == SIZE);
+        assert(Obj::GetAliveObjectCount() == 0);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+        v.EmplaceBack(1);
+        assert(v.Size() == 1 && v[0].id == 1);
+    }
+    {
+        Vector<int> v(SIZE);
+        v[SIZE / 2 - 1] = 42;
+        v.Resize(SIZE / 2);
+        assert(!v.ShrinkIfWasteAbove(0.6));
+        assert(v.Capacity() == SIZE);
+        assert(v.ShrinkIfWasteAbove(0.25));
+        assert(v.Capacity() == SIZE / 2 && v.Size() == SIZE / 2);
+        assert(v[SIZE / 2 - 1] == 42);
+        assert(!v.ShrinkIfWasteAbove(0.0));
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v.Resize(SIZE / 2);
+        v[0].throw_on_copy = true;
+        const Obj* data = &v[0];
+        // перемещение не выбрасывает исключений, поэтому элементы перемещаются
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE / 2 && &v[0] != data);
+        assert(Obj::num_moved == SIZE / 2);
+        assert(Obj::GetAliveObjectCount() == SIZE / 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+#if defined(VECTOR_ENABLE_STATS)
+struct StatsRelocatable {
+    int value = 0;
+};
+
+struct StatsNonRelocatable {
+    StatsNonRelocatable() = default;
+    StatsNonRelocatable(const StatsNonRelocatable&) = default;
+    StatsNonRelocatable(StatsNonRelocatable&& other) noexcept
+        : value(std::move(other.value)) {
+    }
+    StatsNonRelocatable& operator=(const StatsNonRelocatable&) = default;
+    StatsNonRelocatable& operator=(StatsNonRelocatable&&) = default;
+    std::string value;
+};
+#endif
+
+void Test16() {
+#if defined(VECTOR_ENABLE_STATS)
+    auto &registry = VectorStatsRegistry::Instance();
+    registry.Reset();
+    {
+        auto &stats = vector_stats::For<StatsRelocatable>();
         {
-            cerr << "std::vector:"sv << endl;
-            C::Reset();
-            vector<C> v(NUM);
-            Dump();
-            v.push_back(c);
+            Vector<StatsRelocatable> v;
+            for (int i = 0; i < 5; ++i) {
+                v.PushBack({i});
+            }
+            // буфер растёт через realloc: 0 -> 1 -> 2 -> 4 -> 8
+            assert(stats.allocations == 4);
+            assert(stats.deallocations == 3);
+            assert(stats.reallocations == 3);
+            assert(stats.bytes_moved == (1 + 2 + 4) * sizeof(StatsRelocatable));
+            assert(stats.peak_capacity == 8);
         }
-        Dump();
-    } catch (...) {
+        assert(stats.deallocations == 4);
+        assert(stats.releases == 1);
+        assert(stats.wasted_capacity == 3);
     }
-    try {
-        const size_t NUM = 10;
-        C c;
+    {
+        auto &stats = vector_stats::For<StatsNonRelocatable>();
         {
-            cerr << "Vector:"sv << endl;
-            C::Reset();
-            Vector<C> v(NUM);
-            Dump();
-            v.PushBack(c);
+            Vector<StatsNonRelocatable> v;
+            // перенос пустого вектора не считается реаллокацией
+            v.Reserve(4);
+            v.Resize(4);
+            v.EmplaceBack();
+            v.Insert(v.begin(), StatsNonRelocatable());
+            v.Reserve(16);
+            assert(stats.allocations == 3);
+            assert(stats.deallocations == 2);
+            assert(stats.reallocations == 2);
+            assert(stats.bytes_moved == (4 + 6) * sizeof(StatsNonRelocatable));
+            assert(stats.bytes_allocated == (4 + 8 + 16) * sizeof(StatsNonRelocatable));
+            v.ShrinkToFit();
+            assert(stats.reallocations == 3);
+        }
+        assert(stats.releases == 1);
+        assert(stats.wasted_capacity == 0);
+    }
+    {
+        std::ostringstream out;
+        registry.DumpJson(out);
+        const std::string json = out.str();
+        assert(json.front() == '{');
+        assert(json.find("StatsRelocatable\": {\"allocations\": 4, \"deallocations\": 4") != std::string::npos);
+    }
+    registry.Reset();
+    assert(vector_stats::For<StatsRelocatable>().allocations == 0);
+#endif
+}
+
+// сравнение без предупреждения -Wfloat-equal: в тестах значения float вычисляются точно
+template <typename T>
+bool SameValue(T lhs, T rhs) {
+    return !(lhs < rhs) && !(rhs < lhs);
+}
+
+template <typename T>
+void CheckSimdAlgorithms(size_t size) {
+    Vector<T> v(size);
+    for (size_t i = 0; i < size; ++i) {
+        // небольшие целые значения, чтобы суммы float вычислялись точно
+        v[i] = static_cast<T>(static_cast<int>((i * 7) % 23) - 11);
+    }
+    const T* data = v.begin();
+    assert(simd::Count(v, T(5)) == static_cast<size_t>(std::count(data, data + size, T(5))));
+    assert(simd::Find(v, T(5)) == std::find(data, data + size, T(5)));
+    assert(simd::Find(v, T(100)) == v.end());
+    simd::SumType<T> sum{};
+    simd::SumType<T> dot{};
+    for (size_t i = 0; i < size; ++i) {
+        sum += v[i];
+        dot += static_cast<simd::SumType<T>>(v[i]) * static_cast<simd::SumType<T>>(v[i]);
+    }
+    assert(SameValue(simd::Sum(v), sum));
+    assert(SameValue(simd::Dot(v, v), dot));
+    if (size > 0) {
+        // экстремумы в последнем элементе проверяют обработку хвоста
+        v[size - 1] = T(-50);
+        const auto [min, max] = simd::MinMax(v);
+        assert(SameValue(min, T(-50)) && SameValue(max, *std::max_element(data, data + size)));
+        v[size - 1] = T(50);
+        assert(SameValue(simd::MinMax(v).second, T(50)));
+    }
+    simd::Fill(v, T(3));
+    assert(simd::Count(v, T(3)) == size);
+    simd::Transform(v, [](T x) {
+        return static_cast<T>(x * 2);
+    });
+    assert(std::all_of(v.begin(), v.end(), [](T x) {
+        return SameValue(x, T(6));
+    }));
+}
+
+void Test17() {
+    for (const auto isa : {simd::Isa::SCALAR, simd::Isa::NEON, simd::Isa::AVX2, simd::Isa::AVX512}) {
+        simd::SetIsa(isa);
+        if (simd::CurrentIsa() != isa) {
+            continue;
+        }
+        for (size_t size = 0; size < 70; ++size) {
+            CheckSimdAlgorithms<int32_t>(size);
+            CheckSimdAlgorithms<float>(size);
+        }
+        CheckSimdAlgorithms<int32_t>(10000);
+        CheckSimdAlgorithms<float>(10000);
+    }
+    simd::SetIsa(simd::SupportedIsa());
+    {
+        // типы без векторной реализации обрабатываются скалярными циклами
+        Vector<double> v(10);
+        simd::Fill(v, 1.5);
+        assert(SameValue(simd::Sum(v), 15.0));
+        assert(simd::Count(v, 1.5) == 10);
+        const Vector<int32_t> big{1, 2, std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::max()};
+        // сумма int32_t не переполняется
+        assert(simd::Sum(big) == 3 + 2 * int64_t{std::numeric_limits<int32_t>::max()});
+    }
+}
+
+template <size_t ALIGNMENT, typename T>
+bool IsAligned(const T *ptr) {
+    return reinterpret_cast<uintptr_t>(ptr) % ALIGNMENT == 0;
+}
+
+// тип с выравниванием больше alignof(std::max_align_t)
+struct alignas(128) OverAligned {
+    int value = 0;
+};
+
+void Test18() {
+    {
+        AlignedVector<float> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(static_cast<float>(i));
+            assert(IsAligned<CACHE_LINE_SIZE>(v.begin()));
+        }
+        AlignedVector<float> copy(v);
+        assert(IsAligned<CACHE_LINE_SIZE>(copy.begin()) && copy.Size() == 1000);
+        AlignedVector<float> moved(std::move(copy));
+        assert(IsAligned<CACHE_LINE_SIZE>(moved.begin()) && copy.Size() == 0);
+        moved.Insert(moved.begin(), 5, -1.0f);
+        moved.ShrinkToFit();
+        assert(IsAligned<CACHE_LINE_SIZE>(moved.begin()) && moved.Capacity() == 1005);
+    }
+    {
+        AlignedVector<char, PAGE_SIZE> v(10);
+        assert(IsAligned<PAGE_SIZE>(v.begin()));
+        v.Reserve(PAGE_SIZE * 3);
+        assert(IsAligned<PAGE_SIZE>(v.begin()));
+    }
+    {
+        // выравнивание не может быть меньше alignof(T)
+        AlignedVector<OverAligned, 16> v(3);
+        assert(IsAligned<alignof(OverAligned)>(v.begin()));
+        // стандартный аллокатор выделяет память под такие типы через std::align_val_t
+        Vector<OverAligned> plain;
+        for (int i = 0; i < 10; ++i) {
+            plain.PushBack(OverAligned{i});
+            assert(IsAligned<alignof(OverAligned)>(plain.begin()));
+        }
+    }
+    {
+        // большие буферы выравниваются по границе большой страницы
+        AlignedVector<int64_t> v(HUGE_PAGE_SIZE / sizeof(int64_t) * 2);
+        assert(IsAligned<HUGE_PAGE_SIZE>(v.begin()));
+        Vector<int64_t, AlignedAllocator<int64_t, CACHE_LINE_SIZE, false>> small_pages(HUGE_PAGE_SIZE);
+        assert(IsAligned<CACHE_LINE_SIZE>(small_pages.begin()));
+    }
+    {
+        AlignedAllocator<int> alloc;
+        try {
+            [[maybe_unused]] int *p = alloc.allocate(std::numeric_limits<size_t>::max() / 2);
+            assert(false);
+        } catch (const std::bad_array_new_length&) {
+        }
+    }
+}
+
+// Объект со счётчиками, безопасными для использования из нескольких потоков
+struct ParallelObj {
+    ParallelObj() {
+        Check();
+        ++alive;
+    }
+    ParallelObj(const ParallelObj& other)
+        : value(other.value) {
+        Check();
+        ++alive;
+    }
+    ParallelObj& operator=(const ParallelObj&) = default;
+    ~ParallelObj() {
+        --alive;
+    }
+
+    static void Check() {
+        if (++constructions == throw_at) {
+            throw std::runtime_error("Oops");
+        }
+    }
+
+    static void Reset() {
+        constructions = 0;
+        throw_at = 0;
+    }
+
+    std::string value = "parallel object with a heap-allocated string";
+
+    inline static std::atomic<int> alive = 0;
+    inline static std::atomic<int> constructions = 0;
+    inline static int throw_at = 0;
+};
+
+void Test19() {
+    const size_t SIZE = 10000;
+    // маленькие части, чтобы работа действительно распределялась между потоками
+    const ParallelTag tag(4, 100);
+    {
+        ParallelObj::Reset();
+        Vector<ParallelObj> v(tag, SIZE);
+        assert(v.Size() == SIZE && ParallelObj::alive == static_cast<int>(SIZE));
+        v[SIZE - 1].value = "last";
+
+        Vector<ParallelObj> copy(tag, v);
+        assert(copy.Size() == SIZE && copy[SIZE - 1].value == "last");
+        assert(ParallelObj::alive == static_cast<int>(2 * SIZE));
+
+        Vector<ParallelObj> target(10);
+        target.CopyFrom(tag, v);
+        assert(target.Size() == SIZE && target[SIZE - 1].value == "last");
+        assert(ParallelObj::alive == static_cast<int>(3 * SIZE));
+
+        copy.Clear(tag);
+        assert(copy.Size() == 0 && copy.Capacity() == SIZE);
+        assert(ParallelObj::alive == static_cast<int>(2 * SIZE));
+    }
+    assert(ParallelObj::alive == 0);
+    {
+        // исключение в одном из потоков: созданные остальными потоками элементы удаляются
+        ParallelObj::Reset();
+        ParallelObj::throw_at = static_cast<int>(SIZE / 2);
+        try {
+            Vector<ParallelObj> v(tag, SIZE);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(ParallelObj::alive == 0);
+    }
+    {
+        ParallelObj::Reset();
+        Vector<ParallelObj> v(tag, SIZE);
+        Vector<ParallelObj> target(5);
+        ParallelObj::throw_at = ParallelObj::constructions + static_cast<int>(SIZE / 3);
+        try {
+            target.CopyFrom(tag, v);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(target.Size() == 0);
+        assert(ParallelObj::alive == static_cast<int>(SIZE));
+    }
+    assert(ParallelObj::alive == 0);
+    {
+        // маленькие векторы и тривиальные типы обрабатываются в текущем потоке
+        Vector<int> small(parallel, 10);
+        assert(small.Size() == 10 && small[9] == 0);
+        Vector<int> big(ParallelTag(3, 1), 1000);
+        Vector<int> big_copy(parallel, big);
+        assert(big_copy.Size() == 1000 && big_copy[999] == 0);
+    }
+}
+
+void Test20() {
+    {
+        ConcurrentVector<int> v;
+        const int* first = &v.PushBack(1);
+        for (int i = 2; i <= 1000; ++i) {
+            v.EmplaceBack(i);
+        }
+        // при росте элементы не переносятся
+        assert(&v[0] == first && *first == 1);
+        assert(v.Size() == 1000 && v[999] == 1000);
+        assert(!v.IsConstructed(1000));
+        Vector<int> frozen = v.Freeze();
+        assert(v.Size() == 0);
+        assert(frozen.Size() == 1000);
+        for (size_t i = 0; i < frozen.Size(); ++i) {
+            assert(frozen[i] == static_cast<int>(i + 1));
+        }
+    }
+    {
+        const size_t THREADS = 8;
+        const size_t PER_THREAD = 20000;
+        ConcurrentVector<std::string> v;
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < THREADS; ++t) {
+            workers.emplace_back([&v, t] {
+                for (size_t i = 0; i < PER_THREAD; ++i) {
+                    v.EmplaceBack(std::to_string(t * PER_THREAD + i));
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        assert(v.Size() == THREADS * PER_THREAD);
+        Vector<std::string> frozen = v.Freeze();
+        assert(frozen.Size() == THREADS * PER_THREAD);
+        std::vector<bool> seen(THREADS * PER_THREAD);
+        for (const auto& value : frozen) {
+            const size_t index = std::stoul(value);
+            assert(!seen[index]);
+            seen[index] = true;
+        }
+    }
+    {
+        // позиция, конструирование элемента в которой завершилось исключением, пропускается
+        Obj::ResetCounters();
+        ConcurrentVector<Obj> v;
+        v.EmplaceBack(1);
+        Obj::default_construction_throw_countdown = 1;
+        try {
+            v.EmplaceBack();
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        v.EmplaceBack(3);
+        assert(v.Size() == 3 && !v.IsConstructed(1) && v.IsConstructed(2));
+        assert(Obj::GetAliveObjectCount() == 2);
+        Vector<Obj> frozen = v.Freeze();
+        assert(frozen.Size() == 2 && frozen[0].id == 1 && frozen[1].id == 3);
+        assert(Obj::GetAliveObjectCount() == 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test21() {
+    {
+        // перенос элементов другого вектора
+        Vector<std::unique_ptr<int>> a;
+        a.PushBack(std::make_unique<int>(1));
+        Vector<std::unique_ptr<int>> b;
+        for (int i = 2; i <= 5; ++i) {
+            b.PushBack(std::make_unique<int>(i));
+        }
+        const size_t b_capacity = b.Capacity();
+        a.Append(std::move(b));
+        assert(a.Size() == 5 && *a[0] == 1 && *a[4] == 5);
+        assert(b.Size() == 0 && b.Capacity() == b_capacity);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> a(2);
+        Vector<Obj> b(3);
+        a.Append(std::move(b));
+        assert(a.Size() == 5 && b.Size() == 0);
+        assert(Obj::GetAliveObjectCount() == 5);
+        a.Append(std::move(a));
+        assert(a.Size() == 5);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        const size_t THREADS = 6;
+        const size_t PER_THREAD = 10000;
+        ShardedVector<std::pair<size_t, size_t>> sharded;
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < THREADS; ++t) {
+            workers.emplace_back([&sharded, t] {
+                sharded.LocalShard().Reserve(PER_THREAD);
+                for (size_t i = 0; i < PER_THREAD; ++i) {
+                    sharded.EmplaceBack(t, i);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        assert(sharded.Size() == THREADS * PER_THREAD);
+
+        Vector<std::pair<size_t, size_t>> out;
+        out.EmplaceBack(THREADS, 0);
+        sharded.MergeInto(out);
+        assert(out.Size() == THREADS * PER_THREAD + 1);
+        assert(out.Capacity() == out.Size());
+        assert(sharded.Size() == 0);
+        // порядок элементов каждого потока сохраняется
+        std::vector<size_t> next(THREADS + 1, 0);
+        for (const auto& [thread, index] : out) {
+            assert(index == next[thread]);
+            ++next[thread];
+        }
+    }
+    {
+        // два контейнера в одном потоке не смешивают шарды
+        ShardedVector<int> a;
+        ShardedVector<int> b;
+        for (int i = 0; i < 10; ++i) {
+            a.PushBack(i);
+            b.PushBack(-i);
+        }
+        Vector<int> out;
+        a.MergeInto(out);
+        assert(out.Size() == 10 && out[9] == 9);
+        b.Clear();
+        assert(b.Size() == 0);
+        a.PushBack(100);
+        out.Clear();
+        a.MergeInto(out);
+        assert(out.Size() == 1 && out[0] == 100);
+    }
+}
+
+void Test22() {
+    Obj::ResetCounters();
+    {
+        // рост не переносит элементы, и ссылки на них остаются действительными
+        SegmentedVector<Obj, 8> v;
+        Obj &first = v.EmplaceBack(1);
+        const Obj *first_address = &first;
+        for (int i = 2; i <= 100; ++i) {
+            v.EmplaceBack(i);
+        }
+        assert(v.Size() == 100);
+        assert(v.BlockCount() == 13 && v.Capacity() == 104);
+        assert(Obj::num_moved == 0 && Obj::num_copied == 0);
+        assert(&v[0] == first_address && first.id == 1);
+        // аргумент может ссылаться на элемент самого вектора
+        v.PushBack(v[0]);
+        assert(v.Size() == 101 && v[100].id == 1);
+        v.PopBack();
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(v[i].id == static_cast<int>(i) + 1);
+        }
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // итераторы произвольного доступа
+        SegmentedVector<int, 4> v;
+        for (int i = 0; i < 50; ++i) {
+            v.PushBack((i * 37) % 50);
+        }
+        std::sort(v.begin(), v.end());
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(v[i] == static_cast<int>(i));
+        }
+        const auto &cv = v;
+        auto it = std::lower_bound(cv.begin(), cv.end(), 21);
+        assert(it - cv.begin() == 21 && *it == 21 && it[2] == 23);
+        SegmentedVector<int, 4>::const_iterator cit = v.begin() + 10;
+        assert(*cit == 10 && cit > cv.begin() && cv.end() - cit == 40);
+        assert(std::accumulate(cv.cbegin(), cv.cend(), 0) == 49 * 50 / 2);
+
+        // вставка и удаление в середине
+        v.Insert(v.begin() + 5, -1);
+        assert(v.Size() == 51 && v[5] == -1 && v[4] == 4 && v[6] == 5 && v[50] == 49);
+        auto after = v.Erase(v.begin() + 5);
+        assert(v.Size() == 50 && *after == 5);
+        after = v.Erase(v.begin() + 10, v.begin() + 20);
+        assert(v.Size() == 40 && *after == 20 && v[9] == 9);
+
+        // обход по блокам
+        long long sum = 0;
+        size_t blocks = 0;
+        v.ForEachBlock([&](int *data, size_t count) {
+            assert(count <= 4);
+            for (size_t i = 0; i < count; ++i) {
+                sum += data[i];
+            }
+            ++blocks;
+        });
+        assert(blocks == 10);
+        assert(sum == std::accumulate(v.begin(), v.end(), 0LL));
+
+        v.Resize(3);
+        assert(v.Size() == 3 && v.Capacity() == 52);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 4);
+        v.Resize(6);
+        assert(v[5] == 0 && v.Capacity() == 8);
+    }
+    {
+        // копирование, перемещение и исключения
+        SegmentedVector<Obj, 3> v;
+        for (int i = 0; i < 10; ++i) {
+            v.EmplaceBack(i);
+        }
+        SegmentedVector<Obj, 3> copy(v);
+        assert(copy.Size() == 10 && copy[9].id == 9);
+        v[5].throw_on_copy = true;
+        try {
+            SegmentedVector<Obj, 3> broken(v);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        try {
+            copy = v;
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(copy.Size() == 10);
+        SegmentedVector<Obj, 3> moved(std::move(copy));
+        assert(moved.Size() == 10 && copy.Size() == 0);
+        copy = std::move(moved);
+        assert(copy.Size() == 10 && copy[3].id == 3);
+        Obj::default_construction_throw_countdown = 4;
+        try {
+            SegmentedVector<Obj, 3> sized(5);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        SegmentedVector<std::string> strings{"a", "b", "c"};
+        assert(strings.Size() == 3 && strings[2] == "c");
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test23() {
+    struct Record {
+        int id;
+        double weight;
+    };
+    const std::string path = (std::filesystem::temp_directory_path()
+                              / ("mapped_vector_test_" + std::to_string(::getpid()) + ".bin")).string();
+    std::filesystem::remove(path);
+    const int COUNT = 10000;
+    {
+        // новый файл создаётся, растёт и при закрытии укорачивается до размера вектора
+        MappedVector<Record> v(path);
+        assert(v.Size() == 0 && !v.IsReadOnly());
+        for (int i = 0; i < COUNT; ++i) {
+            v.PushBack({i, i * 0.5});
+        }
+        assert(v.Size() == COUNT && v.Capacity() >= COUNT);
+        assert(std::filesystem::file_size(path) == v.Capacity() * sizeof(Record));
+        v.Flush();
+        // аргумент может ссылаться на элемент, который переотображение переносит
+        v.ShrinkToFit();
+        v.EmplaceBack(v[0]);
+        assert(v.Size() == COUNT + 1 && v[COUNT].id == 0);
+        v.PopBack();
+        v.Close();
+        assert(v.Size() == 0);
+    }
+    assert(std::filesystem::file_size(path) == COUNT * sizeof(Record));
+    {
+        // файл открывается без копирования, в том числе несколькими читателями
+        const MappedVector<Record> reader(path, MapMode::READ_ONLY);
+        MappedVector<Record> other_reader(path, MapMode::READ_ONLY);
+        assert(reader.Size() == COUNT && other_reader.IsReadOnly());
+        assert(reader.begin() != other_reader.cbegin());
+        for (int i = 0; i < COUNT; ++i) {
+            assert(reader[static_cast<size_t>(i)].id == i);
+        }
+        assert(std::as_const(other_reader)[COUNT - 1].id == COUNT - 1);
+        try {
+            other_reader.PushBack({0, 0});
+            assert(false);
+        } catch (const std::logic_error&) {
+        }
+        // неконстантный доступ позволил бы записать в память, отображённую только для чтения
+        try {
+            other_reader[0].id = -1;
+            assert(false);
+        } catch (const std::logic_error&) {
+        }
+        try {
+            other_reader.begin();
+            assert(false);
+        } catch (const std::logic_error&) {
+        }
+        assert(std::as_const(other_reader).begin() == other_reader.cbegin());
+        assert(other_reader.Size() == COUNT);
+    }
+    {
+        // дозапись в существующий файл; деструктор закрывает файл
+        MappedVector<Record> v(path, MapMode::READ_WRITE);
+        const Record extra[] = {{-1, 1.0}, {-2, 2.0}};
+        v.Append(extra, 2);
+        v.Resize(COUNT + 3);
+        assert(v[COUNT + 1].id == -2 && v[COUNT + 2].id == 0);
+        MappedVector<Record> moved(std::move(v));
+        assert(moved.Size() == COUNT + 3 && v.Size() == 0);
+        try {
+            v.Reserve(1);
+            assert(false);
+        } catch (const std::logic_error&) {
+        }
+    }
+    {
+        const MappedVector<Record> v(path, MapMode::READ_ONLY);
+        assert(v.Size() == COUNT + 3 && v[COUNT].id == -1);
+        // длина файла должна быть кратна размеру элемента
+        try {
+            MappedVector<char[3]> wrong(path, MapMode::READ_ONLY);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+    }
+    std::filesystem::remove(path);
+    try {
+        MappedVector<Record> missing(path, MapMode::READ_ONLY);
+        assert(false);
+    } catch (const std::system_error &e) {
+        assert(e.code() == std::errc::no_such_file_or_directory);
+    }
+}
+
+void Test24() {
+    {
+        // тривиально копируемые элементы: заголовок и один блок данных
+        Vector<int> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(i * 3);
+        }
+        std::stringstream stream;
+        Serialize(stream, v);
+        assert(stream.str().size() == 20 + 1000 * sizeof(int));
+        Vector<int> loaded{7, 8};
+        Deserialize(stream, loaded);
+        assert(loaded.Size() == 1000 && loaded.Capacity() == 1000);
+        assert(std::equal(v.begin(), v.end(), loaded.begin()));
+    }
+    {
+        // поэлементная запись строк и вложенных векторов
+        Vector<Vector<std::string>> v;
+        v.EmplaceBack(Vector<std::string>{"alpha", "", "gamma"});
+        v.EmplaceBack();
+        v.EmplaceBack(Vector<std::string>{std::string(5000, 'x')});
+        std::stringstream stream;
+        Serialize(stream, v);
+        Vector<Vector<std::string>> loaded;
+        Deserialize(stream, loaded);
+        assert(loaded.Size() == 3 && loaded[1].Size() == 0);
+        assert(loaded[0][0] == "alpha" && loaded[0][1].empty() && loaded[0][2] == "gamma");
+        assert(loaded[2][0] == v[2][0]);
+    }
+    {
+        // чтение порциями в заранее зарезервированный вектор
+        Vector<double> v(100);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            v[i] = static_cast<double>(i) / 4;
+        }
+        std::stringstream stream;
+        Serialize(stream, v);
+        VectorReader<double> reader(stream);
+        assert(reader.Size() == 100 && reader.Remaining() == 100);
+        Vector<double> loaded;
+        loaded.Reserve(reader.Size());
+        const double *data = loaded.begin();
+        size_t chunks = 0;
+        while (reader.Remaining() > 0) {
+            assert(reader.ReadChunk(loaded, 30) <= 30);
+            ++chunks;
+        }
+        assert(chunks == 4 && loaded.Size() == 100 && loaded.begin() == data);
+        assert(std::equal(v.begin(), v.end(), loaded.begin(), [](double a, double b) {
+            return !(a < b) && !(b < a);
+        }));
+    }
+    {
+        // ошибки формата и обрыв данных
+        Vector<int> v{1, 2, 3};
+        std::stringstream stream;
+        Serialize(stream, v);
+        const std::string bytes = stream.str();
+
+        // тип элементов проверяется по их размеру
+        Vector<double> wrong_type;
+        std::stringstream wrong_type_stream(bytes);
+        try {
+            Deserialize(wrong_type_stream, wrong_type);
+            assert(false);
+        } catch (const SerializationError&) {
+        }
+        std::stringstream garbage("not a vector at all");
+        try {
+            Deserialize(garbage, v);
+            assert(false);
+        } catch (const SerializationError&) {
+        }
+        std::stringstream truncated(bytes.substr(0, bytes.size() - 2));
+        Vector<int> partial;
+        try {
+            Deserialize(truncated, partial);
+            assert(false);
+        } catch (const SerializationError&) {
+        }
+        assert(partial.Size() == 2 && partial[1] == 2);
+
+        // повреждённое число элементов в заголовке: память не резервируется по заголовку,
+        // а размер буфера в байтах не переполняется
+        std::string huge_bytes = bytes;
+        const uint64_t huge_count = (uint64_t{1} << 62) + 1;
+        std::memcpy(huge_bytes.data() + 12, &huge_count, sizeof(huge_count));
+        std::stringstream huge_stream(huge_bytes);
+        Vector<int32_t> huge;
+        try {
+            Deserialize(huge_stream, huge);
+            assert(false);
+        } catch (const SerializationError&) {
+        }
+        assert(huge.Size() == 3 && huge[2] == 3);
+        assert(huge.Capacity() < (size_t{1} << 20));
+    }
+    {
+        // ёмкость, размер которой в байтах не помещается в size_t
+        const size_t huge = std::numeric_limits<size_t>::max() / 4 + 1;
+        Vector<int32_t> ints;
+        try {
+            ints.Reserve(huge);
+            assert(false);
+        } catch (const std::bad_array_new_length&) {
+        }
+        Vector<std::string> strings{"a"};
+        try {
+            strings.Reserve(huge);
+            assert(false);
+        } catch (const std::bad_array_new_length&) {
+        }
+        assert(ints.Capacity() == 0 && strings.Size() == 1 && strings[0] == "a");
+    }
+}
+
+namespace {
+
+int SumSpan(Span<const int> values) {
+    return std::accumulate(values.begin(), values.end(), 0);
+}
+
+}  // namespace
+
+void Test25() {
+    Obj::ResetCounters();
+    {
+        Vector<int> v{1, 2, 3, 4, 5, 6};
+        Span<int> all = v.AsSpan();
+        assert(all.Data() == v.begin() && all.Size() == 6 && !all.Empty());
+        // изменения через представление видны в векторе
+        all[0] = 10;
+        assert(v[0] == 10);
+        Span<int> middle = v.Slice(1, 3);
+        assert(middle.Size() == 3 && middle[0] == 2 && middle[2] == 4);
+        for (int &value : middle) {
+            value *= 2;
+        }
+        assert(v[1] == 4 && v[3] == 8 && v[4] == 5);
+        const int middle_sum = SumSpan(middle);
+        const int total_sum = SumSpan(v.AsSpan());
+        assert(middle_sum == 18 && total_sum == 10 + 4 + 6 + 8 + 5 + 6);
+        assert(middle.First(1)[0] == 4 && middle.Last(1)[0] == 8);
+        assert(v.Slice(6, 0).Empty() && Span<int>().Size() == 0);
+
+        const Vector<int> &cv = v;
+        Span<const int> tail = cv.Slice(4, 2);
+        assert(tail.Size() == 2 && tail[1] == 6);
+        Span<const int> converted = middle;
+        assert(converted.Data() == middle.Data());
+    }
+    {
+        // вектор из представления копирует только его элементы
+        Vector<Obj> v;
+        for (int i = 0; i < 5; ++i) {
+            v.EmplaceBack(i);
+        }
+        const int copied_before = Obj::num_copied;
+        Vector<Obj> part(v.Slice(1, 3));
+        assert(part.Size() == 3 && part.Capacity() == 3 && part[0].id == 1 && part[2].id == 3);
+        assert(Obj::num_copied - copied_before == 3);
+        Vector<Obj> empty(Span<const Obj>{});
+        assert(empty.Size() == 0);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test26() {
+    {
+        // столбцы и строки
+        SoAVector<float, float, int> particles;
+        for (int i = 0; i < 100; ++i) {
+            particles.EmplaceBack(static_cast<float>(i), 1.0f, i % 3);
+        }
+        assert(particles.Size() == 100 && particles.Capacity() == 128);
+        auto [x, v, kind] = particles[10];
+        x += v;
+        kind = 7;
+        assert(std::get<0>(particles[10]) > 10.5f && std::get<2>(particles[10]) == 7);
+
+        Span<float> xs = particles.Column<0>();
+        const Span<const float> vs = std::as_const(particles).Column<1>();
+        assert(xs.Size() == 100 && vs.Size() == 100);
+        for (size_t i = 0; i < xs.Size(); ++i) {
+            xs[i] += vs[i];
+        }
+        assert(std::get<0>(particles[99]) > 99.5f);
+
+        particles.Erase(0, 10);
+        assert(particles.Size() == 90 && std::get<2>(particles[0]) == 7);
+        particles.Erase(0);
+        assert(std::get<2>(particles[0]) == 11 % 3);
+        particles.Resize(95);
+        assert(std::get<1>(particles[94]) < 0.5f && std::get<2>(particles[94]) == 0);
+        particles.PopBack();
+        particles.ShrinkToFit();
+        assert(particles.Size() == 94 && particles.Capacity() == 94);
+
+        SoAVector<float, float, int> copy(particles);
+        particles.Clear();
+        assert(copy.Size() == 94 && std::get<2>(copy[0]) == 2);
+        particles = std::move(copy);
+        assert(particles.Size() == 94 && copy.Size() == 0);
+        // аргумент может ссылаться на поле самого вектора
+        particles.EmplaceBack(std::get<0>(particles[0]), std::get<1>(particles[0]), std::get<2>(particles[0]));
+        assert(std::get<2>(particles[94]) == 2);
+    }
+    {
+        // исключение при переносе оставляет вектор нетронутым
+        Obj::ResetCounters();
+        ParallelObj::Reset();
+        {
+            SoAVector<Obj, ParallelObj, std::string> rows;
+            rows.Reserve(4);
+            for (int i = 0; i < 4; ++i) {
+                rows.EmplaceBack(Obj(i), ParallelObj(), std::to_string(i));
+            }
+            const int moved_before = Obj::num_moved;
+            const size_t capacity = rows.Capacity();
+            ParallelObj::throw_at = ParallelObj::constructions + 3;
+            try {
+                rows.EmplaceBack(Obj(4), ParallelObj(), "4");
+                assert(false);
+            } catch (const std::runtime_error&) {
+            }
+            assert(rows.Size() == 4 && rows.Capacity() == capacity);
+            // новая строка создана, но столбец Obj не переносился
+            assert(Obj::num_moved == moved_before + 1);
+            for (size_t i = 0; i < rows.Size(); ++i) {
+                assert(std::get<0>(rows[i]).id == static_cast<int>(i) && std::get<2>(rows[i]) == std::to_string(i));
+            }
+            ParallelObj::throw_at = 0;
+            rows.EmplaceBack(Obj(4), ParallelObj(), "4");
+            assert(rows.Size() == 5 && std::get<0>(rows[4]).id == 4);
+            Obj::default_construction_throw_countdown = 3;
+            try {
+                rows.Resize(10);
+                assert(false);
+            } catch (const std::runtime_error&) {
+            }
+            assert(rows.Size() == 5);
+        }
+        assert(Obj::GetAliveObjectCount() == 0 && ParallelObj::alive == 0);
+    }
+}
+
+void Test27() {
+    Obj::ResetCounters();
+    {
+        CowVector<Obj> original;
+        for (int i = 0; i < 10; ++i) {
+            original.EmplaceBack(i);
+        }
+        assert(!original.IsShared());
+        const int copied_before = Obj::num_copied;
+        // копии разделяют элементы
+        CowVector<Obj> copy(original);
+        CowVector<Obj> another;
+        another = copy;
+        assert(original.IsShared() && copy.IsShared());
+        assert(std::as_const(copy).begin() == std::as_const(original).begin());
+        assert(Obj::num_copied == copied_before);
+        assert(std::as_const(copy)[3].id == 3 && copy.Size() == 10);
+
+        // первое изменение копии клонирует элементы, остальные копии не меняются
+        copy[3].id = 30;
+        assert(Obj::num_copied == copied_before + 10);
+        assert(!copy.IsShared() && original.IsShared());
+        assert(std::as_const(original)[3].id == 3 && std::as_const(copy)[3].id == 30);
+        copy[4].id = 40;
+        assert(Obj::num_copied == copied_before + 10);
+
+        // ссылка, полученная до копирования, не должна изменять копию: после выдачи изменяемой
+        // ссылки блок не разделяется, и копия сразу клонирует элементы
+        Obj &held = copy[5];
+        Obj *held_iterator = copy.begin() + 6;
+        CowVector<Obj> snapshot(copy);
+        assert(Obj::num_copied == copied_before + 20);
+        assert(!copy.IsShared() && !snapshot.IsShared());
+        held.id = 50;
+        held_iterator->id = 60;
+        assert(std::as_const(snapshot)[5].id == 5 && std::as_const(snapshot)[6].id == 6);
+        assert(std::as_const(copy)[5].id == 50 && std::as_const(snapshot)[3].id == 30);
+        // копия снимка снова разделяет блок, а Clear восстанавливает разделение у copy
+        CowVector<Obj> shared_snapshot(snapshot);
+        assert(snapshot.IsShared() && Obj::num_copied == copied_before + 20);
+        copy.Clear();
+        copy.EmplaceBack(1);
+        CowVector<Obj> shared_copy(copy);
+        assert(copy.IsShared() && Obj::num_copied == copied_before + 20);
+
+        // аргумент может ссылаться на элемент разделяемого блока
+        another.PushBack(std::as_const(another)[9]);
+        assert(another.Size() == 11 && std::as_const(another)[10].id == 9);
+        assert(!original.IsShared() && original.Size() == 10);
+
+        CowVector<Obj> erased(original);
+        auto it = erased.Erase(std::as_const(erased).begin() + 2);
+        assert(it->id == 3 && erased.Size() == 9 && original.Size() == 10);
+        erased.Insert(std::as_const(erased).begin(), Obj(-1));
+        assert(std::as_const(erased)[0].id == -1);
+
+        CowVector<Obj> cleared(original);
+        cleared.Clear();
+        assert(cleared.Size() == 0 && original.Size() == 10 && !original.IsShared());
+        cleared.EmplaceBack(5);
+        assert(cleared.Size() == 1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // снимок читают много потоков, один поток изменяет свою копию
+        Vector<int> items(1000);
+        std::iota(items.begin(), items.end(), 0);
+        const CowVector<int> snapshot(std::move(items));
+        std::atomic<long long> total = 0;
+        Vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t) {
+            readers.EmplaceBack([&snapshot, &total, t] {
+                for (int round = 0; round < 50; ++round) {
+                    CowVector<int> local(snapshot);
+                    if (t == 0) {
+                        local.PushBack(round);
+                    }
+                    total += std::accumulate(std::as_const(local).begin(), std::as_const(local).begin() + 1000, 0LL);
+                }
+            });
+        }
+        for (auto &reader : readers) {
+            reader.join();
+        }
+        assert(total == 4LL * 50 * 999 * 1000 / 2);
+        assert(!snapshot.IsShared());
+    }
+}
+
+namespace {
+
+// строка, копирование которой выбрасывает исключение, когда обнуляется обратный счётчик copies_left
+struct ThrowingCopyString {
+    ThrowingCopyString(const char *text)
+        : text(text) {
+    }
+    ThrowingCopyString(const ThrowingCopyString &other)
+        : text(other.text) {
+        if (copies_left > 0 && --copies_left == 0) {
+            throw std::runtime_error("Oops");
+        }
+    }
+    ThrowingCopyString(ThrowingCopyString&&) noexcept = default;
+    ThrowingCopyString& operator=(const ThrowingCopyString&) = default;
+    ThrowingCopyString& operator=(ThrowingCopyString&&) noexcept = default;
+
+    bool operator<(const ThrowingCopyString &rhs) const noexcept {
+        return text < rhs.text;
+    }
+
+    std::string text;
+    static inline int copies_left = 0;
+};
+
+}  // namespace
+
+void Test28() {
+    {
+        // поиск без ветвлений совпадает с std::lower_bound
+        Vector<int> sorted;
+        for (int i = 0; i < 100; ++i) {
+            sorted.PushBack(i * 2);
+        }
+        for (size_t size = 0; size <= sorted.Size(); ++size) {
+            for (int key = -1; key <= 200; ++key) {
+                const auto expected = std::lower_bound(sorted.begin(), sorted.begin() + size, key) - sorted.begin();
+                assert(BranchlessLowerBound(sorted.begin(), size, key) == static_cast<size_t>(expected));
+            }
+        }
+    }
+    {
+        // построение из неотсортированных данных с повторами
+        FlatSet<int> set(Vector<int>{5, 1, 4, 1, 5, 9, 2, 6, 5, 3});
+        assert(set.Size() == 7 && std::is_sorted(set.begin(), set.end()));
+        assert(set.Contains(9) && !set.Contains(7) && *set.LowerBound(7) == 9);
+        assert(set.Find(8) == set.end());
+        auto [it, inserted] = set.Insert(7);
+        assert(inserted && *it == 7 && set.Size() == 8);
+        assert(!set.Insert(7).second);
+        assert(set.Erase(1) == 1 && set.Erase(1) == 0);
+
+        // слияние с отсортированным диапазоном
+        const Vector<int> more{0, 3, 8, 8, 10};
+        set.InsertSorted(more);
+        const std::set<int> expected{0, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+        assert(set.Size() == expected.size() && std::equal(set.begin(), set.end(), expected.begin()));
+
+        FlatSet<std::string, std::greater<std::string>> names{"b", "c", "a", "b"};
+        assert(names.Size() == 3 && *names.begin() == "c" && names.Contains("a"));
+    }
+    {
+        FlatMap<int, std::string> map(Vector<std::pair<int, std::string>>{{3, "three"}, {1, "one"}, {3, "again"}});
+        assert(map.Size() == 2 && map.At(3) == "three" && *map.Find(1) == "one");
+        assert(map.Find(2) == nullptr && !map.Contains(2));
+        map[2] = "two";
+        assert(map.Size() == 3 && map.Keys()[1] == 2 && map.Values()[1] == "two");
+        auto [value, inserted] = map.TryEmplace(2, "other");
+        assert(!inserted && *value == "two");
+        assert(map.Insert(0, "zero").second && map.Keys()[0] == 0);
+        try {
+            map.At(42);
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+        for (auto &text : map.Values()) {
+            text += "!";
+        }
+        assert(map.At(0) == "zero!");
+
+        const Vector<std::pair<int, std::string>> more{{-1, "minus"}, {2, "dup"}, {5, "five"}};
+        map.InsertSorted(more);
+        std::map<int, std::string> expected{{-1, "minus"}, {0, "zero!"}, {1, "one!"}, {2, "two!"},
+                                            {3, "three!"}, {5, "five"}};
+        assert(map.Size() == expected.size());
+        size_t index = 0;
+        for (const auto &[key, text] : expected) {
+            assert(map.Keys()[index] == key && map.Values()[index] == text);
+            ++index;
+        }
+        assert(map.Erase(2) == 1 && map.Erase(2) == 0 && map.Size() == 5);
+        assert(map.Keys()[3] == 3 && map.At(3) == "three!");
+    }
+    {
+        // исключение при копировании добавляемых ключей и значений не изменяет контейнер
+        FlatSet<ThrowingCopyString> set{"b", "d", "f"};
+        const Vector<ThrowingCopyString> more{"a", "c", "e"};
+        ThrowingCopyString::copies_left = 2;
+        try {
+            set.InsertSorted(more);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(set.Size() == 3 && set.Contains("b") && set.Contains("d") && set.Contains("f"));
+        assert(set.begin()->text == "b" && std::is_sorted(set.begin(), set.end()));
+        set.InsertSorted(more);
+        assert(set.Size() == 6 && set.begin()->text == "a" && set.Contains("e"));
+
+        FlatMap<int, ThrowingCopyString> map{{1, "one"}, {3, "three"}, {5, "five"}};
+        const Vector<std::pair<int, ThrowingCopyString>> pairs{{0, "zero"}, {2, "two"}, {4, "four"}};
+        ThrowingCopyString::copies_left = 3;
+        try {
+            map.InsertSorted(pairs);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(map.Size() == 3 && map.Keys()[0] == 1 && map.Values()[0].text == "one");
+        assert(map.At(3).text == "three" && map.At(5).text == "five");
+        map.InsertSorted(pairs);
+        assert(map.Size() == 6 && map.At(0).text == "zero" && map.At(1).text == "one");
+    }
+}
+
+void Test29() {
+    Obj::ResetCounters();
+    {
+        // очередь с переходом через конец буфера
+        RingVector<Obj> queue;
+        for (int i = 0; i < 8; ++i) {
+            queue.EmplaceBack(i);
+        }
+        assert(queue.Capacity() == 8);
+        for (int i = 0; i < 5; ++i) {
+            assert(queue.Front().id == i);
+            queue.PopFront();
+        }
+        for (int i = 8; i < 13; ++i) {
+            queue.EmplaceBack(i);
+        }
+        assert(queue.Size() == 8 && queue.Capacity() == 8);
+        auto [first, second] = queue.AsSpans();
+        assert(first.Size() == 3 && second.Size() == 5 && first[0].id == 5 && second[0].id == 8);
+
+        // рост переносит два участка, аргумент может ссылаться на элемент очереди
+        const int moved_before = Obj::num_moved;
+        queue.PushBack(queue.Front());
+        assert(queue.Capacity() == 16 && queue.Size() == 9);
+        assert(Obj::num_moved == moved_before + 8);
+        assert(queue.Back().id == 5 && queue.AsSpans().second.Empty());
+        for (size_t i = 0; i + 1 < queue.Size(); ++i) {
+            assert(queue[i].id == static_cast<int>(i) + 5);
+        }
+
+        queue.PushFront(Obj(4));
+        queue.EmplaceFront(3);
+        assert(queue.Front().id == 3 && queue[1].id == 4 && queue.Size() == 11);
+        auto spans = std::as_const(queue).AsSpans();
+        assert(spans.first.Size() == 2 && spans.second.Size() == 9);
+        queue.PopBack();
+        assert(queue.Back().id == 12);
+
+        // итераторы произвольного доступа
+        assert(std::count_if(queue.begin(), queue.end(), [](const Obj &obj) {
+            return obj.id % 2 == 0;
+        }) == 5);
+        assert((queue.end() - queue.begin()) == 10 && (queue.begin() + 3)->id == 6);
+
+        RingVector<Obj> copy(queue);
+        assert(copy.Size() == 10 && copy.Capacity() == 16 && copy.Front().id == 3 && copy.Back().id == 12);
+        queue.Clear();
+        queue.ShrinkToFit();
+        assert(queue.Size() == 0 && queue.Capacity() == 0);
+        queue = std::move(copy);
+        assert(queue.Size() == 10 && copy.Size() == 0);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // заполнение с начала при пустом буфере
+        RingVector<int> ring;
+        for (int i = 0; i < 5; ++i) {
+            ring.PushFront(i);
+        }
+        assert(ring.Size() == 5 && ring.Front() == 4 && ring.Back() == 0 && ring.Capacity() == 8);
+        assert(std::is_sorted(ring.begin(), ring.end(), std::greater<int>()));
+        // ёмкость, не округляемая до степени двойки в size_t
+        for (size_t huge : {(std::numeric_limits<size_t>::max() >> 1) + 2, std::numeric_limits<size_t>::max()}) {
+            try {
+                ring.Reserve(huge);
+                assert(false);
+            } catch (const std::length_error&) {
+            }
+        }
+        assert(ring.Size() == 5 && ring.Capacity() == 8);
+    }
+    {
+        // ошибка копирования при переносе оставляет очередь нетронутой
+        ParallelObj::Reset();
+        {
+            RingVector<ParallelObj> ring;
+            for (int i = 0; i < 4; ++i) {
+                ring.EmplaceBack().value = std::to_string(i);
+            }
+            ring.PopFront();
+            ring.EmplaceBack().value = "4";
+            ParallelObj::throw_at = ParallelObj::constructions + 3;
+            try {
+                ring.EmplaceBack();
+                assert(false);
+            } catch (const std::runtime_error&) {
+            }
+            assert(ring.Size() == 4 && ring.Capacity() == 4);
+            assert(ring[0].value == "1" && ring[3].value == "4");
+        }
+        assert(ParallelObj::alive == 0);
+        ParallelObj::Reset();
+    }
+}
+
+namespace {
+
+constexpr StaticVector<int, 8> MakeStaticSequence() {
+    StaticVector<int, 8> v;
+    for (int i = 0; i < 5; ++i) {
+        v.PushBack(i * i);
+    }
+    v.Insert(v.begin() + 1, -1);
+    v.Erase(v.begin() + 3);
+    v.TryEmplaceBack(100);
+    return v;
+}
+
+}  // namespace
+
+void Test30() {
+    {
+        // тривиальные типы доступны в constexpr
+        constexpr StaticVector<int, 8> v = MakeStaticSequence();
+        static_assert(v.Size() == 6 && v.Capacity() == 8);
+        static_assert(v[0] == 0 && v[1] == -1 && v[2] == 1 && v[3] == 9 && v[5] == 100);
+        static_assert(std::is_trivially_destructible_v<StaticVector<int, 8>>);
+        static_assert(sizeof(StaticVector<int, 8>) == 8 * sizeof(int) + sizeof(size_t));
+
+        StaticVector<int, 4> small{1, 2, 3};
+        assert(small.TryEmplaceBack(4) != nullptr);
+        assert(small.TryEmplaceBack(5) == nullptr && small.Size() == 4);
+        try {
+            small.PushBack(5);
+            assert(false);
+        } catch (const std::length_error&) {
+        }
+        try {
+            small.Resize(5);
+            assert(false);
+        } catch (const std::length_error&) {
+        }
+        small.Erase(small.begin(), small.begin() + 2);
+        assert(small.Size() == 2 && small[0] == 3 && small[1] == 4);
+        small.Resize(4);
+        assert(small[3] == 0);
+    }
+    Obj::ResetCounters();
+    {
+        // нетривиальные элементы создаются и удаляются без обращения к куче
+        StaticVector<Obj, 6> v;
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack(i);
+        }
+        auto it = v.Emplace(v.begin() + 1, 10);
+        assert(it->id == 10 && v.Size() == 5 && v[2].id == 1 && v[4].id == 3);
+        // аргумент может ссылаться на сдвигаемый элемент
+        v.Insert(v.begin(), v[4]);
+        assert(v[0].id == 3 && v[1].id == 0 && v.Size() == 6);
+        assert(v.TryEmplaceBack(7) == nullptr);
+        try {
+            v.Insert(v.begin(), Obj(1));
+            assert(false);
+        } catch (const std::length_error&) {
+        }
+        v.Erase(v.begin() + 1);
+        assert(v.Size() == 5 && v[1].id == 10);
+
+        StaticVector<Obj, 6> copy(v);
+        assert(copy.Size() == 5 && copy[4].id == 3);
+        StaticVector<Obj, 6> other{Obj(1), Obj(2)};
+        other = copy;
+        assert(other.Size() == 5 && other[1].id == 10);
+        copy.Resize(2);
+        other = std::move(copy);
+        assert(other.Size() == 2 && other[1].id == 10);
+        v[2].throw_on_copy = true;
+        try {
+            StaticVector<Obj, 6> broken(v);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        Obj::default_construction_throw_countdown = 3;
+        try {
+            StaticVector<Obj, 6> sized(5);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        v.PopBack();
+        v.Clear();
+        assert(v.Size() == 0);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+#if defined(VECTOR_CONSTEXPR_ENABLED)
+namespace {
+
+// таблица строится Vector при компиляции и копируется в статическую память
+constexpr std::array<int, 8> MakeSquareTable() {
+    Vector<int> squares;
+    for (int i = 0; i < 10; ++i) {
+        squares.PushBack(i * i);
+    }
+    squares.Insert(squares.begin(), -1);
+    squares.Erase(squares.begin() + 1, squares.begin() + 4);
+    squares.Resize(8);
+    std::array<int, 8> table{};
+    std::copy(squares.begin(), squares.end(), table.begin());
+    return table;
+}
+
+// элементы, которые не переносятся побайтово, и вложенные векторы
+constexpr size_t NestedTotal() {
+    Vector<Vector<int>> rows;
+    for (int i = 1; i <= 4; ++i) {
+        rows.EmplaceBack(static_cast<size_t>(i));
+    }
+    rows.Emplace(rows.begin() + 1, Vector<int>{1, 2, 3});
+    Vector<Vector<int>> copy = rows;
+    copy.PopBack();
+    rows = std::move(copy);
+    rows.ShrinkToFit();
+    size_t total = 0;
+    for (const auto &row : rows) {
+        total += row.Size();
+    }
+    return total * 10 + rows.Size();
+}
+
+} // namespace
+#endif
+
+void Test31() {
+#if defined(VECTOR_CONSTEXPR_ENABLED)
+    constexpr std::array<int, 8> TABLE = MakeSquareTable();
+    static_assert(TABLE[0] == -1 && TABLE[1] == 9 && TABLE[6] == 64 && TABLE[7] == 81);
+    static_assert(NestedTotal() == (1 + 3 + 2 + 3) * 10 + 4);
+    // те же функции работают и во время выполнения
+    assert(MakeSquareTable() == TABLE);
+    assert(NestedTotal() == 94);
+#endif
+}
+
+void Test32() {
+    Obj::ResetCounters();
+    {
+        // элемент с перемещением без исключений вставляется без временного объекта:
+        // одно перемещение в неинициализированную память, сдвиг и перемещающее присваивание
+        Vector<Obj> v;
+        v.Reserve(8);
+        for (int i = 0; i < 5; ++i) {
+            v.EmplaceBack(i);
+        }
+        const int moved = Obj::num_moved;
+        const int move_assigned = Obj::num_move_assigned;
+        v.Insert(v.begin() + 1, Obj(10));
+        assert(Obj::num_moved == moved + 1);
+        assert(Obj::num_move_assigned == move_assigned + 3 + 1);
+        assert(v[1].id == 10 && v[2].id == 1 && v[5].id == 4);
+        // вставляемое значение - сдвигаемый элемент вектора
+        v.Insert(v.begin(), v[3]);
+        assert(v[0].id == 2 && v[4].id == 2 && v.Size() == 7);
+        v.Insert(v.begin() + 2, std::move(v[2]));
+        assert(v[2].id == 10 && v.Size() == 8);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // тривиально перемещаемые типы сдвигаются побайтово, в том числе без реаллокации
+        Vector<std::unique_ptr<int>> v;
+        v.Reserve(8);
+        for (int i = 0; i < 4; ++i) {
+            v.PushBack(std::make_unique<int>(i));
+        }
+        v.Insert(v.begin(), std::move(v[3]));
+        assert(*v[0] == 3 && *v[1] == 0 && !v[4] && v.Size() == 5);
+
+        Vector<std::pair<int, int>> pairs{{1, 2}, {3, 4}, {5, 6}};
+        pairs.Reserve(8);
+        // аргументы ссылаются на сдвигаемые элементы, поэтому создаётся временный объект
+        pairs.Emplace(pairs.begin(), pairs[1].second, pairs[2].first);
+        assert(pairs[0] == std::make_pair(4, 5) && pairs[2] == std::make_pair(3, 4));
+        const int first = 7;
+        pairs.Emplace(pairs.begin() + 1, first, pairs[0].first);
+        assert(pairs[1] == std::make_pair(7, 4) && pairs.Size() == 5);
+        // при реаллокации через realloc аргументы-элементы сохраняются до освобождения буфера
+        pairs.ShrinkToFit();
+        pairs.Emplace(pairs.begin() + 2, pairs[4].second, first);
+        assert(pairs[2] == std::make_pair(6, 7) && pairs[5] == std::make_pair(5, 6));
+        pairs.ShrinkToFit();
+        pairs.Emplace(pairs.begin(), 0, first);
+        assert(pairs[0] == std::make_pair(0, 7) && pairs.Size() == 7);
+    }
+    {
+        // исключение копирования при переносе в новый буфер во время вставки в середину:
+        // вектор остаётся прежним, и ни один элемент не удаляется дважды
+        ParallelObj::Reset();
+        {
+            auto make_full = [] {
+                Vector<ParallelObj> v;
+                v.Reserve(4);
+                for (int i = 0; i < 4; ++i) {
+                    v.EmplaceBack().value = std::to_string(i);
+                }
+                return v;
+            };
+            auto check_intact = [](const Vector<ParallelObj> &v) {
+                assert(v.Size() == 4 && v.Capacity() == 4);
+                for (size_t i = 0; i < v.Size(); ++i) {
+                    assert(v[i].value == std::to_string(i));
+                }
+            };
+            const ParallelObj inserted;
+            // новый элемент, две первые копии, исключение при копировании хвоста
+            for (int throw_after : {4, 2}) {
+                Vector<ParallelObj> v = make_full();
+                ParallelObj::throw_at = ParallelObj::constructions + throw_after;
+                try {
+                    v.Insert(v.begin() + 2, inserted);
+                    assert(false);
+                } catch (const std::runtime_error&) {
+                }
+                check_intact(v);
+                assert(ParallelObj::alive == 5);
+            }
+            {
+                Vector<ParallelObj> v = make_full();
+                ParallelObj::throw_at = ParallelObj::constructions + 4;
+                try {
+                    v.Emplace(v.begin() + 1);
+                    assert(false);
+                } catch (const std::runtime_error&) {
+                }
+                check_intact(v);
+                ParallelObj::throw_at = ParallelObj::constructions + 3;
+                try {
+                    v.EmplaceBack();
+                    assert(false);
+                } catch (const std::runtime_error&) {
+                }
+                check_intact(v);
+            }
+            {
+                // вставка диапазона: два новых элемента, две копии, исключение в хвосте
+                Vector<ParallelObj> v = make_full();
+                const std::vector<ParallelObj> range(2);
+                ParallelObj::throw_at = ParallelObj::constructions + 6;
+                try {
+                    v.Insert(v.begin() + 2, range.begin(), range.end());
+                    assert(false);
+                } catch (const std::runtime_error&) {
+                }
+                check_intact(v);
+                assert(ParallelObj::alive == 7);
+                v.Insert(v.begin() + 2, range.begin(), range.end());
+                assert(v.Size() == 6 && v[1].value == "1" && v[4].value == "2");
+            }
+        }
+        assert(ParallelObj::alive == 0);
+        ParallelObj::Reset();
+    }
+}
+
+void Test33() {
+    auto &pool = VectorBufferPool::Instance();
+    pool.Trim();
+    pool.ResetStats();
+    static_assert(std::is_same_v<PooledVector<int>::allocator_type, PooledAllocator<int>>);
+    assert(VectorBufferPool::BlockSize(1) == 64 && VectorBufferPool::BlockSize(65) == 128);
+    assert(VectorBufferPool::BlockSize(VectorBufferPool::MAX_BLOCK_SIZE + 1) == 0);
+    {
+        // ёмкость растёт до размера блока: 16 элементов int занимают блок в 64 байта
+        PooledVector<int> v;
+        v.PushBack(1);
+        assert(v.Capacity() == 16);
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Capacity() == 128 && v[100] == 99);
+    }
+    {
+        const BufferPoolStats stats = pool.Stats();
+        // 64, 128, 256 и 512 байт выделены из кучи и возвращены в пул
+        assert(stats.misses == 4 && stats.hits == 0 && stats.returns == 4);
+    }
+    {
+        // повторное создание векторов тех же размеров обходится без кучи
+        PooledVector<int> v(100);
+        // второй блок в 512 байт в пуле отсутствует
+        PooledVector<int> copy(v);
+        PooledVector<std::string> names{"a", "b"};
+        names.Reserve(4);
+        Vector<int, PooledAllocator<int>> big(VectorBufferPool::MAX_BLOCK_SIZE);
+        const BufferPoolStats stats = pool.Stats();
+        assert(stats.hits == 3 && stats.misses == 4 + 1 && stats.oversized == 1);
+        assert(SameValue(stats.HitRate(), 3.0 / 8.0));
+    }
+    {
+        // блоки, заранее выделенные для множества векторов одного размера
+        pool.ResetStats();
+        pool.Reserve(1000 * sizeof(double), 8);
+        Vector<PooledVector<double>> buffers;
+        for (int i = 0; i < 8; ++i) {
+            buffers.EmplaceBack().Reserve(1000);
+        }
+        const BufferPoolStats stats = pool.Stats();
+        assert(stats.hits == 8 && stats.misses == 0);
+    }
+    {
+        // блоки свободно переходят между потоками, кэш потока при завершении переносится в общий список
+        std::atomic<size_t> done{0};
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 8; ++t) {
+            workers.emplace_back([&done, t] {
+                PooledVector<PooledVector<int>> rows;
+                for (int i = 0; i < 500; ++i) {
+                    PooledVector<int> row(static_cast<size_t>(i % 64 + t));
+                    row.PushBack(i);
+                    rows.PushBack(std::move(row));
+                    if (rows.Size() > 16) {
+                        rows.Erase(rows.begin());
+                    }
+                }
+                done.fetch_add(rows.Size());
+            });
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        assert(done == 8 * 16);
+        const BufferPoolStats stats = pool.Stats();
+        assert(stats.hits + stats.misses == stats.returns);
+        assert(stats.HitRate() > 0.5);
+    }
+    pool.Trim();
+}
+
+namespace {
+
+struct CheckedIndex {
+    int value = 0;
+};
+
+struct TrappedIndex {
+    int value = 0;
+};
+
+}  // namespace
+
+template <>
+struct VectorBoundsCheck<CheckedIndex> : std::integral_constant<BoundsCheck, BoundsCheck::THROW> {};
+
+template <>
+struct VectorBoundsCheck<TrappedIndex> : std::integral_constant<BoundsCheck, BoundsCheck::TRAP> {};
+
+void Test34() {
+    {
+        // At() проверяет индекс независимо от режима operator[]
+        Vector<int> v{1, 2, 3};
+        static_assert(noexcept(v[0]));
+        static_assert(!noexcept(v.At(0)));
+        assert(v.At(2) == 3);
+        v.At(0) = 10;
+        assert(std::as_const(v).At(0) == 10);
+        try {
+            v.At(3);
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+        v.Clear();
+        try {
+            std::as_const(v).At(0);
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+    }
+    {
+        // режим THROW для типа элементов: operator[] выбрасывает исключение и не является noexcept
+        static_assert(VectorBoundsCheckV<CheckedIndex> == BoundsCheck::THROW);
+        Vector<CheckedIndex> v(4);
+        static_assert(!noexcept(v[0]));
+        v[3].value = 7;
+        assert(v[3].value == 7);
+        try {
+            v[4].value = 1;
+            assert(false);
+        } catch (const std::out_of_range &e) {
+            assert(std::string(e.what()).find("4") != std::string::npos);
+        }
+        v.Reserve(16);
+        try {
+            std::as_const(v)[4];
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+        assert(v.Size() == 4);
+    }
+    {
+        // режим TRAP: корректные обращения работают как обычно
+        Vector<TrappedIndex> v(3);
+        static_assert(noexcept(v[0]));
+        for (size_t i = 0; i < v.Size(); ++i) {
+            v[i].value = static_cast<int>(i);
+        }
+        v.Insert(v.begin(), TrappedIndex{-1});
+        assert(v[0].value == -1 && v[3].value == 2);
+    }
+}
+
+void Test35() {
+    {
+        // подсказка появляется после MIN_SAMPLES векторов и покрывает их размер с запасом не более четверти
+        ReserveHintSite site;
+        for (size_t i = 0; i < ReserveHintSite::MIN_SAMPLES; ++i) {
+            assert(site.Hint() == 0);
+            HintedVector<int> v(site);
+            assert(v.Capacity() == 0 && v.Site() == &site);
+            for (int j = 0; j < 100; ++j) {
+                v.EmplaceBack(j);
+            }
+        }
+        assert(site.Hint() == 111);
+        assert(site.Stats().overflows == ReserveHintSite::MIN_SAMPLES);
+        {
+            HintedVector<int> v(site);
+            assert(v.Reserved() == 111 && v.Capacity() == 111);
+            const int *data = v.begin();
+            for (int j = 0; j < 100; ++j) {
+                v.EmplaceBack(j);
+            }
+            // элементы добавлены без реаллокаций
+            assert(v.begin() == data && v.Capacity() == 111);
+        }
+        const ReserveHintStats stats = site.Stats();
+        assert(stats.samples == ReserveHintSite::MIN_SAMPLES + 1);
+        assert(stats.overflows == ReserveHintSite::MIN_SAMPLES && stats.hint == 111);
+        site.Reset();
+        assert(site.Hint() == 0 && site.Stats().samples == 0);
+    }
+    {
+        // подсказка покрывает 90% векторов, редкие большие векторы растут как обычно
+        ReserveHintSite site;
+        for (size_t i = 0; i < ReserveHintSite::MIN_SAMPLES; ++i) {
+            HintedVector<std::string> v(site);
+            v.Resize(i % 16 == 0 ? 1000 : 10);
+        }
+        assert(site.Hint() == 11);
+        ReserveHintSite all(100);
+        for (size_t i = 0; i < ReserveHintSite::MIN_SAMPLES; ++i) {
+            HintedVector<int> v(all);
+            v.Resize(i % 16 == 0 ? 1000 : 10);
+        }
+        assert(all.Hint() == 1023);
+    }
+    {
+        // перемещённый вектор не сообщает размер, копия сообщает свой
+        ReserveHintSite site;
+        {
+            HintedVector<int> a(site);
+            a.Resize(5);
+            HintedVector<int> b(std::move(a));
+            assert(a.Site() == nullptr && b.Site() == &site);
+            HintedVector<int> c(b);
+            assert(c.Site() == &site && c.Reserved() == 5);
+            HintedVector<int> d(site);
+            d = std::move(c);
+            assert(d.Size() == 5 && c.Site() == nullptr);
+            assert(site.Stats().samples == 1);
+        }
+        // b, d и прежнее содержимое d
+        assert(site.Stats().samples == 3);
+    }
+    {
+        // места по меткам и по положению в исходном коде
+        ReserveHintSite *first = nullptr;
+        for (int i = 0; i < 3; ++i) {
+            HintedVector<int> v(VECTOR_HINT_SITE());
+            assert(first == nullptr || v.Site() == first);
+            first = v.Site();
+        }
+        HintedVector<int> tagged("request/headers");
+        assert(tagged.Site() == &ReserveHintRegistry::Instance().Site("request/headers"));
+        assert(first != tagged.Site());
+        tagged.Resize(3);
+    }
+    {
+        std::ostringstream out;
+        ReserveHintRegistry::Instance().DumpJson(out);
+        assert(out.str().find("\"request/headers\": {\"samples\": 1") != std::string::npos);
+        assert(out.str().find("test.cpp:") != std::string::npos);
+        ReserveHintRegistry::Instance().Reset();
+    }
+    {
+        // одно место из нескольких потоков
+        ReserveHintSite site;
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 4; ++t) {
+            workers.emplace_back([&site] {
+                for (int i = 0; i < 1000; ++i) {
+                    HintedVector<int> v(site);
+                    v.Resize(static_cast<size_t>(20 + i % 5));
+                }
+            });
+        }
+        for (auto &worker : workers) {
+            worker.join();
         }
-        Dump();
-    } catch (...) {
+        const ReserveHintStats stats = site.Stats();
+        assert(stats.samples == 4000);
+        assert(stats.hint >= 24 && stats.hint <= 27);
     }
 }
 
@@ -648,7 +2813,35 @@ int main() {
         Test4();
         Test5();
         Test6();
-        Benchmark();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test13();
+        Test14();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+        Test20();
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+        Test25();
+        Test26();
+        Test27();
+        Test28();
+        Test29();
+        Test30();
+        Test31();
+        Test32();
+        Test33();
+        Test34();
+        Test35();
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
     }
@@ -1,253 +1,1599 @@
 #pragma once
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <initializer_list>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <memory_resource>
 #include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
 #include <utility>
 
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#if defined(VECTOR_ENABLE_STATS)
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+#endif
+
+// ---------------------------------- CONSTEXPR -----------------------------------------
+
+/* В C++20 основные операции Vector и RawMemory доступны в constexpr: память выделяется через
+   std::allocator, а элементы создаются std::construct_at, поэтому таблицы можно строить при
+   компиляции и копировать в статическую память. Память, выделенная при вычислении константного
+   выражения, должна быть освобождена в нём же. В C++17 макрос VECTOR_CONSTEXPR пуст */
+#if defined(__cpp_lib_constexpr_dynamic_alloc) && defined(__cpp_lib_is_constant_evaluated)
+#define VECTOR_CONSTEXPR_ENABLED
+#define VECTOR_CONSTEXPR constexpr
+#else
+#define VECTOR_CONSTEXPR
+#endif
+
+// true при вычислении константного выражения: в этом случае недоступны malloc, memcpy, статистика
+// и размещающий new. В C++17 всегда false
+constexpr bool IsConstantEvaluated() noexcept {
+#if defined(VECTOR_CONSTEXPR_ENABLED)
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+// ------------------------------ TRIVIALLY RELOCATABLE ---------------------------------
+
+// Тип считается тривиально перемещаемым, если его объект можно перенести в другую область памяти
+// побайтовым копированием, не вызывая move-конструктор для нового объекта и деструктор для старого.
+// Автоматически таковыми считаются тривиально копируемые типы, для остальных типов признак
+// можно включить явной специализацией шаблона
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+// std::unique_ptr со стандартным удалителем хранит только указатель и не зависит от своего адреса
+template <typename T>
+struct IsTriviallyRelocatable<std::unique_ptr<T>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool IsTriviallyRelocatableV = IsTriviallyRelocatable<T>::value;
+
+// ---------------------------------- STATISTICS ----------------------------------------
+
+/* Сбор статистики выделения памяти и переноса элементов, включаемый макросом VECTOR_ENABLE_STATS.
+   Счётчики ведутся отдельно для каждого типа элементов в общем для процесса реестре
+   VectorStatsRegistry и выводятся в JSON методом DumpJson. Без макроса функции-хуки
+   из пространства имён vector_stats пусты и не влияют на сгенерированный код */
+
+#if defined(VECTOR_ENABLE_STATS)
+
+struct VectorStats {
+    // выделенные и освобождённые буферы (realloc учитывается как освобождение старого и выделение нового)
+    std::atomic<size_t> allocations{0};
+    std::atomic<size_t> deallocations{0};
+    std::atomic<size_t> bytes_allocated{0};
+    // переносы непустых буферов в новую память и объём перенесённых байт
+    // (для realloc - верхняя оценка, блок может быть расширен на месте)
+    std::atomic<size_t> reallocations{0};
+    std::atomic<size_t> bytes_moved{0};
+    // наибольшая ёмкость буфера в элементах
+    std::atomic<size_t> peak_capacity{0};
+    // число разрушенных векторов и суммарная неиспользованная ёмкость в момент их разрушения
+    std::atomic<size_t> releases{0};
+    std::atomic<size_t> wasted_capacity{0};
+};
+
+class VectorStatsRegistry {
+public:
+    static VectorStatsRegistry& Instance();
+
+    // счётчики для типа с именем type_name; ссылка действительна до конца работы программы
+    VectorStats& Get(const std::string &type_name);
+
+    // выводит счётчики всех типов в виде JSON-объекта
+    void DumpJson(std::ostream &out) const;
+    // обнуляет счётчики всех типов
+    void Reset();
+
+private:
+    VectorStatsRegistry() = default;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<VectorStats>> stats_;
+};
+
+inline VectorStatsRegistry& VectorStatsRegistry::Instance() {
+    // реестр не разрушается, чтобы векторы в статических объектах могли обращаться к нему при завершении
+    static auto *instance = new VectorStatsRegistry();
+    return *instance;
+}
+
+inline VectorStats& VectorStatsRegistry::Get(const std::string &type_name) {
+    std::lock_guard lock(mutex_);
+    auto &stats = stats_[type_name];
+    if (!stats) {
+        stats = std::make_unique<VectorStats>();
+    }
+    return *stats;
+}
+
+inline void VectorStatsRegistry::DumpJson(std::ostream &out) const {
+    std::lock_guard lock(mutex_);
+    out << "{";
+    bool first = true;
+    for (const auto &[type_name, stats] : stats_) {
+        out << (first ? "\n" : ",\n") << "  \"";
+        for (char c : type_name) {
+            if (c == '"' || c == '\\') {
+                out << '\\';
+            }
+            out << c;
+        }
+        out << "\": {"
+            << "\"allocations\": " << stats->allocations.load()
+            << ", \"deallocations\": " << stats->deallocations.load()
+            << ", \"bytes_allocated\": " << stats->bytes_allocated.load()
+            << ", \"reallocations\": " << stats->reallocations.load()
+            << ", \"bytes_moved\": " << stats->bytes_moved.load()
+            << ", \"peak_capacity\": " << stats->peak_capacity.load()
+            << ", \"releases\": " << stats->releases.load()
+            << ", \"wasted_capacity\": " << stats->wasted_capacity.load()
+            << "}";
+        first = false;
+    }
+    out << (first ? "}" : "\n}") << "\n";
+}
+
+inline void VectorStatsRegistry::Reset() {
+    std::lock_guard lock(mutex_);
+    for (auto &[type_name, stats] : stats_) {
+        stats->allocations = 0;
+        stats->deallocations = 0;
+        stats->bytes_allocated = 0;
+        stats->reallocations = 0;
+        stats->bytes_moved = 0;
+        stats->peak_capacity = 0;
+        stats->releases = 0;
+        stats->wasted_capacity = 0;
+    }
+}
+
+#endif
+
+namespace vector_stats {
+
+#if defined(VECTOR_ENABLE_STATS)
+
+template <typename T>
+std::string TypeName() {
+    const char *name = typeid(T).name();
+#if defined(__GNUG__)
+    int status = 0;
+    std::unique_ptr<char, void(*)(void*)> demangled(abi::__cxa_demangle(name, nullptr, nullptr, &status), std::free);
+    if (status == 0 && demangled) {
+        return demangled.get();
+    }
+#endif
+    return name;
+}
+
+// счётчики для типа элементов T; поиск в реестре выполняется один раз для каждого типа
+template <typename T>
+VectorStats& For() {
+    static VectorStats &stats = VectorStatsRegistry::Instance().Get(TypeName<T>());
+    return stats;
+}
+
+template <typename T>
+VECTOR_CONSTEXPR void OnAllocate(size_t capacity) noexcept {
+    if (IsConstantEvaluated()) {
+        return;
+    }
+    auto &stats = For<T>();
+    stats.allocations.fetch_add(1, std::memory_order_relaxed);
+    stats.bytes_allocated.fetch_add(capacity * sizeof(T), std::memory_order_relaxed);
+    size_t peak = stats.peak_capacity.load(std::memory_order_relaxed);
+    while (peak < capacity && !stats.peak_capacity.compare_exchange_weak(peak, capacity, std::memory_order_relaxed)) {
+    }
+}
+
+template <typename T>
+VECTOR_CONSTEXPR void OnDeallocate() noexcept {
+    if (IsConstantEvaluated()) {
+        return;
+    }
+    For<T>().deallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename T>
+VECTOR_CONSTEXPR void OnRelocate(size_t count) noexcept {
+    if (count != 0 && !IsConstantEvaluated()) {
+        auto &stats = For<T>();
+        stats.reallocations.fetch_add(1, std::memory_order_relaxed);
+        stats.bytes_moved.fetch_add(count * sizeof(T), std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+VECTOR_CONSTEXPR void OnRelease(size_t size, size_t capacity) noexcept {
+    if (capacity != 0 && !IsConstantEvaluated()) {
+        auto &stats = For<T>();
+        stats.releases.fetch_add(1, std::memory_order_relaxed);
+        stats.wasted_capacity.fetch_add(capacity - size, std::memory_order_relaxed);
+    }
+}
+
+#else
+
+template <typename T>
+constexpr void OnAllocate(size_t /*capacity*/) noexcept {}
+template <typename T>
+constexpr void OnDeallocate() noexcept {}
+template <typename T>
+constexpr void OnRelocate(size_t /*count*/) noexcept {}
+template <typename T>
+constexpr void OnRelease(size_t /*size*/, size_t /*capacity*/) noexcept {}
+
+#endif
+
+} // namespace vector_stats
+
+// ---------------------------------- BOUNDS CHECK --------------------------------------
+
+/* Проверка индекса в operator[] вектора и RawMemory:
+   NONE   - без проверки;
+   ASSERT - assert, отключаемый макросом NDEBUG;
+   TRAP   - аварийная остановка инструкцией trap. Ветвь помечена как маловероятная и не содержит
+            вызовов, поэтому почти не мешает оптимизации циклов и подходит для рабочих сборок;
+   THROW  - исключение std::out_of_range, operator[] перестаёт быть noexcept.
+   Режим задаётся при сборке макросом VECTOR_BOUNDS_CHECK (например, -DVECTOR_BOUNDS_CHECK=TRAP),
+   а для отдельного типа элементов - специализацией шаблона VectorBoundsCheck.
+   Метод At() проверяет индекс в любом режиме */
+enum class BoundsCheck {
+    NONE,
+    ASSERT,
+    TRAP,
+    THROW,
+};
+
+#if !defined(VECTOR_BOUNDS_CHECK)
+#define VECTOR_BOUNDS_CHECK ASSERT
+#endif
+
+template <typename T>
+struct VectorBoundsCheck : std::integral_constant<BoundsCheck, BoundsCheck::VECTOR_BOUNDS_CHECK> {};
+
+template <typename T>
+inline constexpr BoundsCheck VectorBoundsCheckV = VectorBoundsCheck<T>::value;
+
+#if defined(__GNUC__)
+#define VECTOR_UNLIKELY(condition) __builtin_expect(static_cast<bool>(condition), 0)
+#define VECTOR_COLD __attribute__((cold, noinline))
+#else
+#define VECTOR_UNLIKELY(condition) (condition)
+#define VECTOR_COLD
+#endif
+
+namespace vector_bounds {
+
+[[noreturn]] inline void Trap() noexcept {
+#if defined(__GNUC__)
+    __builtin_trap();
+#else
+    std::abort();
+#endif
+}
+
+// сообщение формируется вне горячего кода
+[[noreturn]] VECTOR_COLD inline void ThrowOutOfRange(size_t index, size_t size) {
+    throw std::out_of_range("Vector index " + std::to_string(index) + " out of range for size " + std::to_string(size));
+}
+
+template <BoundsCheck MODE>
+VECTOR_CONSTEXPR void CheckIndex([[maybe_unused]] size_t index, [[maybe_unused]] size_t size)
+noexcept(MODE != BoundsCheck::THROW) {
+    if constexpr (MODE == BoundsCheck::ASSERT) {
+        assert(index < size);
+    } else if constexpr (MODE == BoundsCheck::TRAP) {
+        if (VECTOR_UNLIKELY(index >= size)) {
+            Trap();
+        }
+    } else if constexpr (MODE == BoundsCheck::THROW) {
+        if (VECTOR_UNLIKELY(index >= size)) {
+            ThrowOutOfRange(index, size);
+        }
+    }
+}
+
+} // namespace vector_bounds
+
 // ---------------------------------- RAW MEMORY ----------------------------------------
 
-namespace {
+namespace {
+
+template <typename T, typename Alloc = std::allocator<T>>
+class RawMemory {
+public:
+    using AllocTraits = std::allocator_traits<Alloc>;
+    static_assert(std::is_same_v<typename AllocTraits::value_type, T>, "Alloc::value_type must be T");
+    static_assert(std::is_same_v<typename AllocTraits::pointer, T*>, "Fancy pointers are not supported");
+
+    // Память под тривиально перемещаемые типы с обычным выравниванием, выделяемая стандартным
+    // аллокатором, берётся через malloc, что позволяет увеличивать её при помощи realloc
+    // без поэлементного переноса
+    static constexpr bool REALLOCATABLE = IsTriviallyRelocatableV<T>
+                                          && alignof(T) <= alignof(std::max_align_t)
+                                          && std::is_same_v<Alloc, std::allocator<T>>;
+    static constexpr bool INDEX_NOEXCEPT = VectorBoundsCheckV<T> != BoundsCheck::THROW;
+
+    RawMemory() noexcept = default;
+    VECTOR_CONSTEXPR explicit RawMemory(const Alloc &alloc) noexcept : alloc_(alloc) {}
+    VECTOR_CONSTEXPR explicit RawMemory(size_t capacity, const Alloc &alloc = Alloc())
+        : alloc_(alloc)
+        , buffer_(Allocate(capacity))
+        , capacity_(capacity)  //
+    {
+    }
+
+    RawMemory(const RawMemory&) = delete;
+    VECTOR_CONSTEXPR RawMemory(RawMemory &&other) noexcept;
+
+    VECTOR_CONSTEXPR ~RawMemory();
+
+    RawMemory& operator=(const RawMemory &rhs) = delete;
+    VECTOR_CONSTEXPR RawMemory& operator=(RawMemory &&rhs) noexcept;
+
+    VECTOR_CONSTEXPR T* operator+(size_t offset) noexcept;
+    VECTOR_CONSTEXPR const T* operator+(size_t offset) const noexcept;
+
+    // индекс проверяется относительно ёмкости в режиме VectorBoundsCheck<T>
+    VECTOR_CONSTEXPR T& operator[](size_t index) noexcept(INDEX_NOEXCEPT);
+    VECTOR_CONSTEXPR const T& operator[](size_t index) const noexcept(INDEX_NOEXCEPT);
+
+    // Обменивает буферы; аллокаторы обмениваются, только если этого требует
+    // propagate_on_container_swap, иначе они должны быть равны
+    VECTOR_CONSTEXPR void Swap(RawMemory &other) noexcept;
+    VECTOR_CONSTEXPR const T* GetAddress() const noexcept;
+    VECTOR_CONSTEXPR T* GetAddress() noexcept;
+    VECTOR_CONSTEXPR size_t Capacity() const noexcept;
+    VECTOR_CONSTEXPR const Alloc& GetAllocator() const noexcept;
+
+    // Освобождает буфер и заменяет аллокатор на alloc (используется при propagate_on_container_copy_assignment)
+    VECTOR_CONSTEXPR void Reset(const Alloc &alloc) noexcept;
+
+    // Изменяет размер буфера, сохраняя его содержимое. Доступно только при REALLOCATABLE:
+    // realloc по возможности расширяет блок на месте, а большие блоки переотображает (mremap)
+    // без копирования данных
+    void Reallocate(size_t new_capacity);
+
+    // Увеличивает ёмкость до фактического размера блока, выделенного malloc (malloc_usable_size).
+    // Для остальных способов выделения памяти ёмкость не меняется
+    void ExtendToUsableSize() noexcept;
+
+private:
+    VECTOR_CONSTEXPR void Init(RawMemory &&other) noexcept;
+    // Выделяет сырую память под n элементов и возвращает указатель на неё. При вычислении
+    // константного выражения память выделяется аллокатором даже при REALLOCATABLE
+    VECTOR_CONSTEXPR T* Allocate(size_t n);
+    // Освобождает сырую память под n элементов, выделенную ранее по адресу buf при помощи Allocate
+    VECTOR_CONSTEXPR void Deallocate(T *buf, size_t n) noexcept;
+
+    Alloc alloc_;
+    T *buffer_ = nullptr;
+    size_t capacity_ = 0;
+}; // class RawMemory
+
+template <typename T, typename Alloc>
+VECTOR_CONSTEXPR RawMemory<T, Alloc>::RawMemory(RawMemory &&other) noexcept
+    : alloc_(other.alloc_)  //
+{
+    Init(std::move(other));
+}
+
+template <typename T, typename Alloc>
+VECTOR_CONSTEXPR RawMemory<T, Alloc>& RawMemory<T, Alloc>::operator=(RawMemory &&rhs) noexcept {
+    if (this != &rhs) {
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+            Deallocate(buffer_, capacity_);
+            buffer_ = nullptr;
+            capacity_ = 0;
+            alloc_ = std::move(rhs.alloc_);
+        } else {
+            assert(alloc_ == rhs.alloc_);
+        }
+        Init(std::move(rhs));
+    }
+    return *this;
+}
+
+template <typename T, typename Alloc>
+VECTOR_CONSTEXPR RawMemory<T, Alloc>::~RawMemory() {
+    Deallocate(buffer_, capacity_);
+}
+
+template <typename T, typename Alloc>
+VECTOR_CONSTEXPR T* RawMemory<T, Alloc>::operator+(size_t offset) noexcept {
+    // Разрешается получать адрес ячейки памяти, следующей за последним элементом массива
+    assert(offset <= capacity_);
+    return buffer_ + offset;
+}
+
+template <typename T, typename Alloc>
+VECTOR_CONSTEXPR const T* RawMemory<T, Alloc>::operator+(size_t offset) const noexcept {
+    return const_cast<RawMemory&>(*this) + offset;
+}
+
+template <typename T, typename Alloc>
+VECTOR_CONSTEXPR const T& RawMemory<T, Alloc>::operator[](size_t index) const noexcept(INDEX_NOEXCEPT) {
+    return const_cast<RawMemory&>(*this)[index];
+}
+
+template <typename T, typename Alloc>
+VECTOR_CONSTEXPR T& RawMemory<T, Alloc>::operator[](size_t index) noexcept(INDEX_NOEXCEPT) {
+    vector_bounds::CheckIndex<VectorBoundsCheckV<T>>(index, capacity_);
+    return buffer_[index];
+}
+
+template <typename T, typename Alloc>
+VECTOR_CONSTEXPR void RawMemory<T, Alloc>::Swap(RawMemory &other) noexcept {
+    if constexpr (AllocTraits::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(alloc_, other.alloc_);
+    } else {
+        assert(alloc_ == other.alloc_);
+    }
+    std::swap(buffer_, other.buffer_);
+    std::swap(capacity_, other.capacity_);
+}
+
+template <typename T, typename Alloc>
+VECTOR_CONSTEXPR const T* RawMemory<T, Alloc>::GetAddress() const noexcept {
+    return buffer_;
+}
+
+template <typename T, typename Alloc>
+VECTOR_CONSTEXPR T* RawMemory<T, Alloc>::GetAddress() noexcept {
+    return buffer_;
+}
+
+template <typename T, typename Alloc>
+VECTOR_CONSTEXPR size_t RawMemory<T, Alloc>::Capacity() const noexcept {
+    return capacity_;
+}
+
+template <typename T, typename Alloc>
+VECTOR_CONSTEXPR const Alloc& RawMemory<T, Alloc>::GetAllocator() const noexcept {
+    return alloc_;
+}
+
+template <typename T, typename Alloc>
+VECTOR_CONSTEXPR void RawMemory<T, Alloc>::Reset(const Alloc &alloc) noexcept {
+    Deallocate(buffer_, capacity_);
+    buffer_ = nullptr;
+    capacity_ = 0;
+    alloc_ = alloc;
+}
+
+template <typename T, typename Alloc>
+VECTOR_CONSTEXPR void RawMemory<T, Alloc>::Init(RawMemory &&other) noexcept {
+    Deallocate(buffer_, capacity_);
+    buffer_ = std::exchange(other.buffer_, nullptr);
+    capacity_ = std::exchange(other.capacity_, 0);
+}
+
+template <typename T, typename Alloc>
+void RawMemory<T, Alloc>::Reallocate(size_t new_capacity) {
+    static_assert(REALLOCATABLE, "Reallocate requires trivially relocatable type");
+    if (new_capacity == 0) {
+        Deallocate(buffer_, capacity_);
+        buffer_ = nullptr;
+        capacity_ = 0;
+        return;
+    }
+    if (new_capacity > std::numeric_limits<size_t>::max() / sizeof(T)) {
+        throw std::bad_array_new_length();
+    }
+    void *new_buffer = std::realloc(static_cast<void*>(buffer_), new_capacity * sizeof(T));
+    if (new_buffer == nullptr) {
+        throw std::bad_alloc();
+    }
+    if (buffer_ != nullptr) {
+        vector_stats::OnDeallocate<T>();
+        vector_stats::OnRelocate<T>(std::min(capacity_, new_capacity));
+    }
+    vector_stats::OnAllocate<T>(new_capacity);
+    buffer_ = static_cast<T*>(new_buffer);
+    capacity_ = new_capacity;
+}
+
+template <typename T, typename Alloc>
+void RawMemory<T, Alloc>::ExtendToUsableSize() noexcept {
+#if defined(__GLIBC__)
+    if constexpr (REALLOCATABLE) {
+        if (buffer_ != nullptr) {
+            capacity_ = std::max(capacity_, malloc_usable_size(static_cast<void*>(buffer_)) / sizeof(T));
+        }
+    }
+#endif
+}
+
+template <typename T, typename Alloc>
+VECTOR_CONSTEXPR T* RawMemory<T, Alloc>::Allocate(size_t n) {
+    if (n == 0) {
+        return nullptr;
+    }
+    // размер в байтах не должен переполнять size_t
+    if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+        throw std::bad_array_new_length();
+    }
+    if (IsConstantEvaluated()) {
+        return AllocTraits::allocate(alloc_, n);
+    }
+    T *buf = nullptr;
+    if constexpr (REALLOCATABLE) {
+        buf = static_cast<T*>(std::malloc(n * sizeof(T)));
+        if (buf == nullptr) {
+            throw std::bad_alloc();
+        }
+    } else {
+        buf = AllocTraits::allocate(alloc_, n);
+    }
+    vector_stats::OnAllocate<T>(n);
+    return buf;
+}
+
+template <typename T, typename Alloc>
+VECTOR_CONSTEXPR void RawMemory<T, Alloc>::Deallocate(T *buf, size_t n) noexcept {
+    if (buf == nullptr) {
+        return;
+    }
+    if (IsConstantEvaluated()) {
+        AllocTraits::deallocate(alloc_, buf, n);
+        return;
+    }
+    vector_stats::OnDeallocate<T>();
+    if constexpr (REALLOCATABLE) {
+        std::free(buf);
+    } else {
+        AllocTraits::deallocate(alloc_, buf, n);
+    }
+}
+
+// ------------------------------ ELEMENTS CONSTRUCTION ---------------------------------
+
+/* Аналоги размещающего new и std::uninitialized_*_n, доступные в constexpr (C++20).
+   Во время выполнения вызываются стандартные алгоритмы, а при вычислении константного
+   выражения элементы создаются по одному через std::construct_at. При исключении уже
+   созданные элементы удаляются */
+
+template <typename T, typename... Args>
+VECTOR_CONSTEXPR T* ConstructAt(T *place, Args&&... args) {
+#if defined(VECTOR_CONSTEXPR_ENABLED)
+    return std::construct_at(place, std::forward<Args>(args)...);
+#else
+    return new (place) T(std::forward<Args>(args)...);
+#endif
+}
+
+// создаёт count элементов в to, вызывая ConstructAt(to + i, *first++) для каждого
+template <typename InputIt, typename T>
+VECTOR_CONSTEXPR T* ConstructEach(InputIt first, size_t count, T *to) {
+    size_t i = 0;
+    try {
+        for (; i < count; ++i, ++first) {
+            ConstructAt(to + i, *first);
+        }
+    } catch (...) {
+        std::destroy_n(to, i);
+        throw;
+    }
+    return to + count;
+}
+
+template <typename InputIt, typename T>
+VECTOR_CONSTEXPR T* UninitializedCopyN(InputIt first, size_t count, T *to) {
+    if (IsConstantEvaluated()) {
+        return ConstructEach(first, count, to);
+    }
+    return std::uninitialized_copy_n(first, count, to);
+}
+
+template <typename T>
+VECTOR_CONSTEXPR T* UninitializedMoveN(T *from, size_t count, T *to) {
+    if (IsConstantEvaluated()) {
+        return ConstructEach(std::make_move_iterator(from), count, to);
+    }
+    return std::uninitialized_move_n(from, count, to).second;
+}
+
+template <typename T>
+VECTOR_CONSTEXPR T* UninitializedValueConstructN(T *to, size_t count) {
+    if (IsConstantEvaluated()) {
+        size_t i = 0;
+        try {
+            for (; i < count; ++i) {
+                ConstructAt(to + i);
+            }
+        } catch (...) {
+            std::destroy_n(to, i);
+            throw;
+        }
+        return to + count;
+    }
+    return std::uninitialized_value_construct_n(to, count);
+}
+
+// ------------------------------ ELEMENTS RELOCATION -----------------------------------
+
+// для тривиально перемещаемых типов переносим элементы одним memcpy без вызова деструкторов,
+// иначе, если move-конструктор не выбрасывает исключений или нет copу-конструктора,
+// то делаем перемещение, иначе копируем элементы из старой области памяти в новую.
+// При вычислении константного выражения memcpy недоступен, и элементы переносятся поштучно
+template <typename T>
+VECTOR_CONSTEXPR void RelocateElements(T *from, size_t size, T *to) {
+    if constexpr (IsTriviallyRelocatableV<T>) {
+        if (!IsConstantEvaluated()) {
+            if (size != 0) {
+                std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), size * sizeof(T));
+            }
+            return;
+        }
+    }
+    if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+        UninitializedMoveN(from, size, to);
+    } else {
+        UninitializedCopyN(from, size, to);
+    }
+    std::destroy_n(from, size);
+}
+
+// перенос элементов RelocateElements не выбрасывает исключений
+template <typename T>
+inline constexpr bool IsNothrowRelocatableV = IsTriviallyRelocatableV<T> || std::is_nothrow_move_constructible_v<T>;
+
+// Переносит size элементов в новую память, учитывая перенос в статистике
+template <typename T>
+VECTOR_CONSTEXPR void SafeMove(T *from, size_t size, T *to) {
+    vector_stats::OnRelocate<T>(size);
+    RelocateElements(from, size, to);
+}
+
+// Переносит size элементов из from в неинициализированный буфер to, оставляя в позиции index
+// промежуток из count элементов, который предварительно заполняет вызов fill(to + index).
+// fill при исключении должна сама удалять созданные ей элементы. При исключении буфер to
+// остаётся неинициализированным, а элементы from - живыми (нетронутыми, если T копируется)
+template <typename T, typename Fill>
+VECTOR_CONSTEXPR void RelocateWithGap(T *from, size_t size, T *to, size_t index, size_t count, Fill &&fill) {
+    fill(to + index);
+    vector_stats::OnRelocate<T>(size);
+    if constexpr (IsNothrowRelocatableV<T>) {
+        // откатывать нечего, поэтому обработчики исключений не нужны
+        RelocateElements(from, index, to);
+        RelocateElements(from + index, size - index, to + (index + count));
+    } else {
+        // обе части копируются (или перемещаются, если копирование невозможно) без удаления
+        // исходных элементов: они удаляются только после успешного переноса всего массива
+        auto transfer = [](T *source, size_t n, T *dest) {
+            if constexpr (std::is_copy_constructible_v<T>) {
+                UninitializedCopyN(source, n, dest);
+            } else {
+                UninitializedMoveN(source, n, dest);
+            }
+        };
+        try {
+            transfer(from, index, to);
+        } catch (...) {
+            std::destroy_n(to + index, count);
+            throw;
+        }
+        try {
+            transfer(from + index, size - index, to + (index + count));
+        } catch (...) {
+            std::destroy_n(to, index + count);
+            throw;
+        }
+        std::destroy_n(from, size);
+    }
+}
+
+// Конструирует элемент в позиции index неинициализированного буфера to и переносит в него
+// size элементов из from, оставляя место под новый элемент
+template <typename T, typename... Args>
+VECTOR_CONSTEXPR void RelocateWithEmplace(T *from, size_t size, T *to, size_t index, Args&&... args) {
+    RelocateWithGap(from, size, to, index, 1, [&](T *gap) {
+        ConstructAt(gap, std::forward<Args>(args)...);
+    });
+}
+
+template <typename T>
+using RemoveCvRefT = std::remove_cv_t<std::remove_reference_t<T>>;
+
+// true, если ни один из аргументов не расположен в памяти [first, last). Сравнивает адреса
+// несвязанных объектов, поэтому недоступна при вычислении константного выражения
+template <typename T, typename... Args>
+bool NoneAliases(const T *first, const T *last, const Args&... args) noexcept {
+    auto inside = [first, last](const void *address) {
+        return std::less_equal<const void*>()(first, address) && std::less<const void*>()(address, last);
+    };
+    return !(inside(static_cast<const void*>(std::addressof(args))) || ...);
+}
+
+// Сдвигает хвост [index, size) массива first на одну позицию вправо побайтово, после чего
+// позиция index считается неинициализированной. Только для тривиально перемещаемых типов
+template <typename T>
+void ShiftTailBytewise(T *first, size_t size, size_t index) noexcept {
+    static_assert(IsTriviallyRelocatableV<T>);
+    if (index < size) {
+        std::memmove(static_cast<void*>(first + (index + 1)), static_cast<const void*>(first + index),
+                     (size - index) * sizeof(T));
+    }
+}
+
+// Вставка value в позицию index со сдвигом хвоста без временного объекта. value может быть
+// элементом массива: после сдвига он читается с новой позиции. Вызывается, только если
+// ни сдвиг, ни создание (присваивание) элемента не выбрасывают исключений
+template <typename T, typename Value>
+void InsertShiftedValue(T *first, size_t size, size_t index, Value &&value) noexcept {
+    auto *source = std::addressof(value);
+    if (!NoneAliases(first + index, first + size, value)) {
+        ++source;
+    }
+    if constexpr (IsTriviallyRelocatableV<T>) {
+        ShiftTailBytewise(first, size, index);
+        ConstructAt(first + index, static_cast<Value&&>(*source));
+    } else {
+        ConstructAt(first + size, std::move(first[size - 1]));
+        std::move_backward(first + index, first + (size - 1), first + size);
+        first[index] = static_cast<Value&&>(*source);
+    }
+}
+
+// Конструирует элемент в позиции index массива first из size элементов, сдвигая хвост на одну
+// позицию вправо. Память за последним элементом должна быть выделена и не инициализирована.
+// Если операции не выбрасывают исключений, элемент создаётся сразу на своём месте,
+// иначе - во временном объекте до сдвига, что даёт строгую гарантию
+template <typename T, typename... Args>
+VECTOR_CONSTEXPR void EmplaceShifted(T *first, size_t size, size_t index, Args&&... args) {
+    if (!IsConstantEvaluated()) {
+        constexpr bool INSERTS_VALUE = sizeof...(Args) == 1 && (std::is_same_v<RemoveCvRefT<Args>, T> && ...);
+        if constexpr (INSERTS_VALUE && IsTriviallyRelocatableV<T> && std::is_nothrow_constructible_v<T, Args...>) {
+            InsertShiftedValue(first, size, index, std::forward<Args>(args)...);
+            return;
+        } else if constexpr (INSERTS_VALUE && std::is_nothrow_move_constructible_v<T>
+                             && std::is_nothrow_move_assignable_v<T> && (std::is_nothrow_assignable_v<T&, Args> && ...)) {
+            InsertShiftedValue(first, size, index, std::forward<Args>(args)...);
+            return;
+        } else if constexpr (IsTriviallyRelocatableV<T> && std::is_nothrow_constructible_v<T, Args...>) {
+            // аргументы, ссылающиеся на сдвигаемые элементы, требуют временного объекта
+            if (NoneAliases(first + index, first + size, args...)) {
+                ShiftTailBytewise(first, size, index);
+                ConstructAt(first + index, std::forward<Args>(args)...);
+                return;
+            }
+        }
+    }
+    T temp(std::forward<Args>(args)...);
+    // память после последнего элемента - не инициализирована, поэтому инициализируем её размещающим new
+    // остальные элементы переносим на один вправо
+    ConstructAt(first + size, std::move(first[size - 1]));
+    std::move_backward(first + index, first + (size - 1), first + size);
+    first[index] = std::move(temp);
+}
+
+// Вставляет count элементов, начиная с first, в позицию index массива data из size элементов,
+// сдвигая хвост за один проход. За последним элементом должно быть место под count элементов.
+// Вставляемый диапазон не должен ссылаться на элементы самого массива
+template <typename T, typename ForwardIt>
+void InsertShifted(T *data, size_t size, size_t index, ForwardIt first, size_t count) {
+    T *pos = data + index;
+    T *old_end = data + size;
+    const size_t elems_after = size - index;
+    if constexpr (IsTriviallyRelocatableV<T>) {
+        std::memmove(static_cast<void*>(pos + count), static_cast<const void*>(pos), elems_after * sizeof(T));
+        try {
+            std::uninitialized_copy_n(first, count, pos);
+        } catch (...) {
+            // возвращаем хвост на место
+            std::memmove(static_cast<void*>(pos), static_cast<const void*>(pos + count), elems_after * sizeof(T));
+            throw;
+        }
+    } else if (elems_after > count) {
+        std::uninitialized_move(old_end - count, old_end, old_end);
+        try {
+            std::move_backward(pos, old_end - count, old_end);
+            std::copy_n(first, count, pos);
+        } catch (...) {
+            // элементы за концом массива не входят в размер вектора и удаляются здесь
+            std::destroy_n(old_end, count);
+            throw;
+        }
+    } else {
+        // часть вставляемых элементов попадает в неинициализированную память за концом массива
+        ForwardIt mid = std::next(first, static_cast<std::ptrdiff_t>(elems_after));
+        T *tail = std::uninitialized_copy_n(mid, count - elems_after, old_end);
+        try {
+            std::uninitialized_move(pos, old_end, tail);
+        } catch (...) {
+            std::destroy(old_end, tail);
+            throw;
+        }
+        try {
+            std::copy_n(first, elems_after, pos);
+        } catch (...) {
+            std::destroy_n(old_end, count);
+            throw;
+        }
+    }
+}
+
+template <typename It, typename = void>
+struct IsInputIterator : std::false_type {};
+
+template <typename It>
+struct IsInputIterator<It, std::void_t<typename std::iterator_traits<It>::iterator_category>>
+    : std::is_convertible<typename std::iterator_traits<It>::iterator_category, std::input_iterator_tag> {};
+
+template <typename It>
+using RequireInputIterator = std::enable_if_t<IsInputIterator<It>::value>;
+
+// Однонаправленный итератор, count раз возвращающий одно и то же значение
+template <typename T>
+class RepeatIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    RepeatIterator(const T &value, size_t index) noexcept : value_(&value), index_(index) {}
+
+    reference operator*() const noexcept {
+        return *value_;
+    }
+    pointer operator->() const noexcept {
+        return value_;
+    }
+    RepeatIterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+    RepeatIterator operator++(int) noexcept {
+        RepeatIterator old = *this;
+        ++index_;
+        return old;
+    }
+    bool operator==(const RepeatIterator &other) const noexcept {
+        return index_ == other.index_;
+    }
+    bool operator!=(const RepeatIterator &other) const noexcept {
+        return index_ != other.index_;
+    }
+
+private:
+    const T *value_;
+    size_t index_;
+};
+
+// ------------------------------- PARALLEL EXECUTION -----------------------------------
+
+// Делит [0, count) на не более чем threads частей не меньше min_chunk элементов и вызывает
+// op(first, last) для каждой части в отдельном потоке (первая часть - в текущем потоке).
+// op при исключении должна сама отменять свою работу. Если хотя бы одна часть завершилась
+// исключением, для успешно обработанных частей вызывается undo(first, last), после чего
+// исключение пробрасывается дальше. Если поток создать не удалось, часть обрабатывается в текущем
+template <typename Operation, typename Undo>
+void ForEachChunk(size_t count, size_t threads, size_t min_chunk, Operation op, Undo undo) {
+    const size_t chunks = std::min(threads, count / std::max(min_chunk, size_t{1}));
+    if (chunks <= 1) {
+        op(size_t{0}, count);
+        return;
+    }
+    std::unique_ptr<std::thread[]> workers;
+    std::unique_ptr<std::exception_ptr[]> errors;
+    try {
+        workers = std::make_unique<std::thread[]>(chunks);
+        errors = std::make_unique<std::exception_ptr[]>(chunks);
+    } catch (const std::bad_alloc&) {
+        op(size_t{0}, count);
+        return;
+    }
+
+    auto first = [&](size_t chunk) {
+        return count / chunks * chunk + std::min(chunk, count % chunks);
+    };
+    auto run = [&](size_t chunk) noexcept {
+        try {
+            op(first(chunk), first(chunk + 1));
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+    for (size_t chunk = 1; chunk < chunks; ++chunk) {
+        try {
+            workers[chunk] = std::thread(run, chunk);
+        } catch (const std::system_error&) {
+            run(chunk);
+        }
+    }
+    run(0);
+    for (size_t chunk = 1; chunk < chunks; ++chunk) {
+        if (workers[chunk].joinable()) {
+            workers[chunk].join();
+        }
+    }
+
+    const auto failed = std::find_if(errors.get(), errors.get() + chunks, [](const std::exception_ptr &error) {
+        return static_cast<bool>(error);
+    });
+    if (failed == errors.get() + chunks) {
+        return;
+    }
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        if (!errors[chunk]) {
+            undo(first(chunk), first(chunk + 1));
+        }
+    }
+    std::rethrow_exception(*failed);
+}
+
+}
+
+// -------------------------------- GROWTH POLICIES -------------------------------------
+
+/* Политика роста определяет ёмкость, до которой увеличивается заполненный вектор:
+   NextCapacity(capacity, required, elem_size) возвращает новую ёмкость (не меньше required)
+   для вектора с текущей ёмкостью capacity и элементами размера elem_size байт.
+   Если USE_USABLE_SIZE == true, ёмкость после выделения памяти увеличивается до фактического
+   размера блока, о котором сообщает распределитель памяти */
+
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Рост в два раза, начиная с одного элемента
+struct DoublingGrowth {
+    static constexpr bool USE_USABLE_SIZE = false;
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t /*elem_size*/) noexcept {
+        return std::max(required, capacity == 0 ? size_t{1} : capacity * 2);
+    }
+};
+
+// Рост в полтора раза: меньше неиспользуемой памяти на больших буферах
+struct OneAndHalfGrowth {
+    static constexpr bool USE_USABLE_SIZE = false;
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t /*elem_size*/) noexcept {
+        return std::max(required, capacity < 2 ? capacity + 1 : capacity + capacity / 2);
+    }
+};
+
+// Начальная ёмкость занимает не меньше одной кэш-линии, дальше рост по политике Base
+template <typename Base = DoublingGrowth>
+struct CacheLineGrowth {
+    static constexpr bool USE_USABLE_SIZE = Base::USE_USABLE_SIZE;
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t elem_size) noexcept {
+        const size_t next = Base::NextCapacity(capacity, required, elem_size);
+        return capacity == 0 ? std::max(next, std::max(size_t{1}, CACHE_LINE_SIZE / elem_size)) : next;
+    }
+};
+
+// Округляет размер в байтах вверх до класса размеров в стиле jemalloc:
+// по четыре класса на каждый интервал между соседними степенями двойки, но с шагом не меньше 16 байт
+constexpr size_t RoundUpToSizeClass(size_t bytes) noexcept {
+    const size_t MIN_SIZE_CLASS = 16;
+    if (bytes <= MIN_SIZE_CLASS) {
+        return MIN_SIZE_CLASS;
+    }
+    size_t group = MIN_SIZE_CLASS;
+    while (group < bytes / 2 + bytes % 2) {
+        group *= 2;
+    }
+    // group < bytes <= 2 * group
+    const size_t spacing = std::max(MIN_SIZE_CLASS, group / 4);
+    return (bytes + spacing - 1) / spacing * spacing;
+}
+
+// Ёмкость, выбранная политикой Base, округляется до класса размеров распределителя памяти,
+// а после выделения увеличивается до фактического размера блока
+template <typename Base = DoublingGrowth>
+struct SizeClassGrowth {
+    static constexpr bool USE_USABLE_SIZE = true;
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t elem_size) noexcept {
+        const size_t next = Base::NextCapacity(capacity, required, elem_size);
+        return std::max(next, RoundUpToSizeClass(next * elem_size) / elem_size);
+    }
+};
 
-template <typename T>
-class RawMemory {
-public:
-    RawMemory() noexcept = default;
-    explicit RawMemory(size_t capacity) : buffer_(Allocate(capacity)) , capacity_(capacity) {}
+// ------------------------------- ALIGNED ALLOCATOR ------------------------------------
 
-    RawMemory(const RawMemory&) = delete;
-    RawMemory(RawMemory &&other) noexcept;
+inline constexpr size_t PAGE_SIZE = 4096;
+inline constexpr size_t HUGE_PAGE_SIZE = size_t{2} << 20;
 
-    ~RawMemory();
+// Аллокатор, выравнивающий буферы по границе ALIGNMENT байт (например, CACHE_LINE_SIZE для SIMD
+// и против ложного разделения кэш-линий или PAGE_SIZE). Выравнивание не бывает меньше alignof(T).
+// Если USE_HUGE_PAGES == true, буферы от HUGE_PAGE_SIZE байт выравниваются по границе большой
+// страницы и помечаются madvise(MADV_HUGEPAGE), чтобы ядро отображало их большими страницами
+template <typename T, size_t ALIGNMENT = CACHE_LINE_SIZE, bool USE_HUGE_PAGES = true>
+class AlignedAllocator {
+    static_assert(ALIGNMENT > 0 && (ALIGNMENT & (ALIGNMENT - 1)) == 0, "Alignment must be a power of two");
 
-    RawMemory& operator=(const RawMemory &rhs) = delete;
-    RawMemory& operator=(RawMemory &&rhs) noexcept;
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, ALIGNMENT, USE_HUGE_PAGES>;
+    };
 
-    T* operator+(size_t offset) noexcept;
-    const T* operator+(size_t offset) const noexcept;
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, ALIGNMENT, USE_HUGE_PAGES>& /*other*/) noexcept {}
 
-    T& operator[](size_t index) noexcept;
-    const T& operator[](size_t index) const noexcept;
+    T* allocate(size_t n);
+    void deallocate(T *buf, size_t n) noexcept;
 
-    void Swap(RawMemory &other) noexcept;
-    const T* GetAddress() const noexcept;
-    T* GetAddress() noexcept;
-    size_t Capacity() const noexcept;
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, ALIGNMENT, USE_HUGE_PAGES>& /*other*/) const noexcept {
+        return true;
+    }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, ALIGNMENT, USE_HUGE_PAGES>& /*other*/) const noexcept {
+        return false;
+    }
 
 private:
-    void Init(RawMemory &&other) noexcept;
-    // Выделяет сырую память под n элементов и возвращает указатель на неё
-    static T* Allocate(size_t n);
-    // Освобождает сырую память, выделенную ранее по адресу buf при помощи Allocate
-    static void Deallocate(T *buf) noexcept;
+    // выравнивание блока из bytes байт; одинаково вычисляется при выделении и освобождении
+    static size_t AlignmentFor(size_t bytes) noexcept;
+}; // class AlignedAllocator
+
+template <typename T, size_t ALIGNMENT, bool USE_HUGE_PAGES>
+T* AlignedAllocator<T, ALIGNMENT, USE_HUGE_PAGES>::allocate(size_t n) {
+    if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+        throw std::bad_array_new_length();
+    }
+    const size_t bytes = n * sizeof(T);
+    const size_t alignment = AlignmentFor(bytes);
+    void *buf = ::operator new(bytes, std::align_val_t{alignment});
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (alignment >= HUGE_PAGE_SIZE) {
+        // ошибка madvise не критична: память остаётся отображённой обычными страницами
+        madvise(buf, bytes, MADV_HUGEPAGE);
+    }
+#endif
+    return static_cast<T*>(buf);
+}
 
-    T *buffer_ = nullptr;
-    size_t capacity_ = 0;
-}; // class RawMemory
+template <typename T, size_t ALIGNMENT, bool USE_HUGE_PAGES>
+void AlignedAllocator<T, ALIGNMENT, USE_HUGE_PAGES>::deallocate(T *buf, size_t n) noexcept {
+    ::operator delete(static_cast<void*>(buf), std::align_val_t{AlignmentFor(n * sizeof(T))});
+}
 
-template <typename T>
-RawMemory<T>::RawMemory(RawMemory &&other) noexcept {
-    Init(std::move(other));
+template <typename T, size_t ALIGNMENT, bool USE_HUGE_PAGES>
+size_t AlignedAllocator<T, ALIGNMENT, USE_HUGE_PAGES>::AlignmentFor(size_t bytes) noexcept {
+    const size_t alignment = std::max(ALIGNMENT, alignof(T));
+    if (USE_HUGE_PAGES && bytes >= HUGE_PAGE_SIZE) {
+        return std::max(alignment, HUGE_PAGE_SIZE);
+    }
+    return alignment;
 }
 
+// ------------------------------------- SPAN -------------------------------------------
+
+// Невладеющее представление непрерывного диапазона из size элементов, начинающегося с data.
+// Обращения за пределы диапазона проверяются assert, как и в RawMemory::operator[]
 template <typename T>
-RawMemory<T>& RawMemory<T>::operator=(RawMemory &&rhs) noexcept {
-    Init(std::move(rhs));
-    return *this;
-}
+class Span {
+public:
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    constexpr Span() noexcept = default;
+    constexpr Span(T *data, size_t size) noexcept;
+    // Span<T> преобразуется в Span<const T>
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+    constexpr Span(const Span<U> &other) noexcept;
+
+    constexpr iterator begin() const noexcept;
+    constexpr iterator end() const noexcept;
+
+    constexpr T* Data() const noexcept;
+    constexpr size_t Size() const noexcept;
+    constexpr bool Empty() const noexcept;
+
+    constexpr T& operator[](size_t index) const noexcept;
+
+    // count элементов, начиная с offset
+    constexpr Span Slice(size_t offset, size_t count) const noexcept;
+    // первые и последние count элементов
+    constexpr Span First(size_t count) const noexcept;
+    constexpr Span Last(size_t count) const noexcept;
+
+private:
+    T *data_ = nullptr;
+    size_t size_ = 0;
+
+}; // class Span
 
 template <typename T>
-RawMemory<T>::~RawMemory() {
-    Deallocate(buffer_);
+constexpr Span<T>::Span(T *data, size_t size) noexcept
+    : data_(data)
+    , size_(size)  //
+{
+    assert(data != nullptr || size == 0);
 }
 
 template <typename T>
-T* RawMemory<T>::operator+(size_t offset) noexcept {
-    // Разрешается получать адрес ячейки памяти, следующей за последним элементом массива
-    assert(offset <= capacity_);
-    return buffer_ + offset;
+template <typename U, typename>
+constexpr Span<T>::Span(const Span<U> &other) noexcept
+    : data_(other.Data())
+    , size_(other.Size())  //
+{
 }
 
 template <typename T>
-const T* RawMemory<T>::operator+(size_t offset) const noexcept {
-    return const_cast<RawMemory&>(*this) + offset;
+constexpr typename Span<T>::iterator Span<T>::begin() const noexcept {
+    return data_;
 }
 
 template <typename T>
-const T& RawMemory<T>::operator[](size_t index) const noexcept {
-    return const_cast<RawMemory&>(*this)[index];
+constexpr typename Span<T>::iterator Span<T>::end() const noexcept {
+    return data_ + size_;
 }
 
 template <typename T>
-T& RawMemory<T>::operator[](size_t index) noexcept {
-    assert(index < capacity_);
-    return buffer_[index];
+constexpr T* Span<T>::Data() const noexcept {
+    return data_;
 }
 
 template <typename T>
-void RawMemory<T>::Swap(RawMemory &other) noexcept {
-    std::swap(buffer_, other.buffer_);
-    std::swap(capacity_, other.capacity_);
+constexpr size_t Span<T>::Size() const noexcept {
+    return size_;
 }
 
 template <typename T>
-const T* RawMemory<T>::GetAddress() const noexcept {
-    return buffer_;
+constexpr bool Span<T>::Empty() const noexcept {
+    return size_ == 0;
 }
 
 template <typename T>
-T* RawMemory<T>::GetAddress() noexcept {
-    return buffer_;
+constexpr T& Span<T>::operator[](size_t index) const noexcept {
+    assert(index < size_);
+    return data_[index];
 }
 
 template <typename T>
-size_t RawMemory<T>::Capacity() const noexcept {
-    return capacity_;
+constexpr Span<T> Span<T>::Slice(size_t offset, size_t count) const noexcept {
+    assert(offset <= size_ && count <= size_ - offset);
+    return {data_ + offset, count};
 }
 
-template<typename T>
-void RawMemory<T>::Init(RawMemory &&other) noexcept {
-    Deallocate(buffer_);
-    buffer_ = std::exchange(other.buffer_, nullptr);
-    capacity_ = std::exchange(other.capacity_, 0);
+template <typename T>
+constexpr Span<T> Span<T>::First(size_t count) const noexcept {
+    return Slice(0, count);
 }
 
 template <typename T>
-T* RawMemory<T>::Allocate(size_t n) {
-    return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+constexpr Span<T> Span<T>::Last(size_t count) const noexcept {
+    assert(count <= size_);
+    return Slice(size_ - count, count);
 }
 
-template <typename T>
-void RawMemory<T>::Deallocate(T *buf) noexcept {
-    if (buf != nullptr) {
-        operator delete(buf);
+// -------------------------------- INDEX ITERATOR --------------------------------------
+
+// Итератор произвольного доступа к элементам контейнера с operator[](size_t) (SegmentedVector,
+// RingVector). Хранит индекс элемента, поэтому остаётся действительным при добавлении элементов в конец
+template <typename Container, typename Value>
+class IndexIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<Value>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value*;
+    using reference = Value&;
+
+    IndexIterator() noexcept = default;
+    IndexIterator(Container *owner, size_t index) noexcept : owner_(owner), index_(index) {}
+    // неконстантный итератор преобразуется в константный
+    template <typename OtherContainer, typename OtherValue,
+              typename = std::enable_if_t<std::is_convertible_v<OtherValue*, Value*>>>
+    IndexIterator(const IndexIterator<OtherContainer, OtherValue> &other) noexcept
+        : owner_(other.owner_)
+        , index_(other.index_)  //
+    {
     }
-}
 
-}
+    reference operator*() const noexcept {
+        return (*owner_)[index_];
+    }
+    pointer operator->() const noexcept {
+        return &(*owner_)[index_];
+    }
+    reference operator[](difference_type offset) const noexcept {
+        return *(*this + offset);
+    }
+
+    IndexIterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+    IndexIterator operator++(int) noexcept {
+        IndexIterator old = *this;
+        ++index_;
+        return old;
+    }
+    IndexIterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+    IndexIterator operator--(int) noexcept {
+        IndexIterator old = *this;
+        --index_;
+        return old;
+    }
+    IndexIterator& operator+=(difference_type offset) noexcept {
+        index_ = static_cast<size_t>(static_cast<difference_type>(index_) + offset);
+        return *this;
+    }
+    IndexIterator& operator-=(difference_type offset) noexcept {
+        return *this += -offset;
+    }
+    friend IndexIterator operator+(IndexIterator it, difference_type offset) noexcept {
+        return it += offset;
+    }
+    friend IndexIterator operator+(difference_type offset, IndexIterator it) noexcept {
+        return it += offset;
+    }
+    friend IndexIterator operator-(IndexIterator it, difference_type offset) noexcept {
+        return it -= offset;
+    }
+    friend difference_type operator-(const IndexIterator &lhs, const IndexIterator &rhs) noexcept {
+        return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const IndexIterator &lhs, const IndexIterator &rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+    friend bool operator!=(const IndexIterator &lhs, const IndexIterator &rhs) noexcept {
+        return lhs.index_ != rhs.index_;
+    }
+    friend bool operator<(const IndexIterator &lhs, const IndexIterator &rhs) noexcept {
+        return lhs.index_ < rhs.index_;
+    }
+    friend bool operator>(const IndexIterator &lhs, const IndexIterator &rhs) noexcept {
+        return lhs.index_ > rhs.index_;
+    }
+    friend bool operator<=(const IndexIterator &lhs, const IndexIterator &rhs) noexcept {
+        return lhs.index_ <= rhs.index_;
+    }
+    friend bool operator>=(const IndexIterator &lhs, const IndexIterator &rhs) noexcept {
+        return lhs.index_ >= rhs.index_;
+    }
+
+private:
+    template <typename, typename>
+    friend class IndexIterator;
+
+    Container *owner_ = nullptr;
+    size_t index_ = 0;
+};
 
 // ------------------------------------ VECTOR ------------------------------------------
 
-template <typename T>
+// Тег конструктора, создающего элементы инициализацией по умолчанию:
+// элементы тривиальных типов остаются неинициализированными
+struct DefaultInitTag {
+    explicit DefaultInitTag() = default;
+};
+inline constexpr DefaultInitTag default_init{};
+
+inline constexpr size_t PARALLEL_MIN_CHUNK = size_t{1} << 14;
+
+// Тег операций, разделяющих работу над элементами между потоками: не более threads потоков
+// (0 - по числу аппаратных потоков), каждому достаётся не меньше min_chunk элементов
+struct ParallelTag {
+    explicit ParallelTag(size_t threads = 0, size_t min_chunk = PARALLEL_MIN_CHUNK) noexcept
+        : threads(threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads)
+        , min_chunk(min_chunk) {
+    }
+    size_t threads;
+    size_t min_chunk;
+};
+inline const ParallelTag parallel{};
+
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = DoublingGrowth>
 class Vector {
 public:
     using iterator = T*;
     using const_iterator = const T*;
+    using allocator_type = Alloc;
 
-    iterator begin() noexcept;
-    iterator end() noexcept;
-    const_iterator begin() const noexcept;
-    const_iterator end() const noexcept;
-    const_iterator cbegin() const noexcept;
-    const_iterator cend() const noexcept;
+    VECTOR_CONSTEXPR iterator begin() noexcept;
+    VECTOR_CONSTEXPR iterator end() noexcept;
+    VECTOR_CONSTEXPR const_iterator begin() const noexcept;
+    VECTOR_CONSTEXPR const_iterator end() const noexcept;
+    VECTOR_CONSTEXPR const_iterator cbegin() const noexcept;
+    VECTOR_CONSTEXPR const_iterator cend() const noexcept;
 
     Vector() noexcept = default;
-    explicit Vector(size_t size);
-    Vector(const Vector &other);
-    Vector(Vector &&other) noexcept;
-
-    Vector& operator=(const Vector &rhs);
-    Vector& operator=(Vector &&rhs) noexcept;
-
-    ~Vector();
-
-    void Swap(Vector &other) noexcept;
-
-    size_t Size() const noexcept;
-    size_t Capacity() const noexcept;
-    void Reserve(size_t new_capacity);
-    void Resize(size_t new_size);
+    VECTOR_CONSTEXPR explicit Vector(const Alloc &alloc) noexcept;
+    VECTOR_CONSTEXPR explicit Vector(size_t size, const Alloc &alloc = Alloc());
+    Vector(size_t size, DefaultInitTag, const Alloc &alloc = Alloc());
+    VECTOR_CONSTEXPR Vector(std::initializer_list<T> init, const Alloc &alloc = Alloc());
+    // копирует элементы диапазона span
+    VECTOR_CONSTEXPR explicit Vector(Span<const T> span, const Alloc &alloc = Alloc());
+    VECTOR_CONSTEXPR Vector(const Vector &other);
+    VECTOR_CONSTEXPR Vector(const Vector &other, const Alloc &alloc);
+    VECTOR_CONSTEXPR Vector(Vector &&other) noexcept;
+    // Параллельные версии конструкторов. При исключении в одном из потоков элементы,
+    // созданные остальными потоками, удаляются, а исключение пробрасывается дальше
+    Vector(ParallelTag tag, size_t size, const Alloc &alloc = Alloc());
+    Vector(ParallelTag tag, const Vector &other);
+
+    VECTOR_CONSTEXPR Vector& operator=(const Vector &rhs);
+    // если аллокаторы не распространяются при перемещении и не равны,
+    // то элементы перемещаются поштучно в память текущего аллокатора
+    VECTOR_CONSTEXPR Vector& operator=(Vector &&rhs) noexcept(ALLOC_MOVES_MEMORY);
+    // Параллельное копирующее присваивание. Текущие элементы удаляются, поэтому
+    // при исключении вектор остаётся пустым
+    void CopyFrom(ParallelTag tag, const Vector &other);
+
+    VECTOR_CONSTEXPR ~Vector();
+
+    VECTOR_CONSTEXPR void Swap(Vector &other) noexcept;
+
+    VECTOR_CONSTEXPR allocator_type GetAllocator() const noexcept;
+
+    VECTOR_CONSTEXPR size_t Size() const noexcept;
+    VECTOR_CONSTEXPR size_t Capacity() const noexcept;
+    VECTOR_CONSTEXPR void Reserve(size_t new_capacity);
+    VECTOR_CONSTEXPR void Resize(size_t new_size);
+    // Изменяет размер, инициализируя новые элементы по умолчанию (без обнуления тривиальных типов),
+    // если они будут сразу же перезаписаны
+    void ResizeForOverwrite(size_t new_size);
+    // Увеличивает размер до count элементов, инициализируя новые по умолчанию, и вызывает
+    // op(data, count), которая заполняет буфер и возвращает итоговое число элементов (не больше count).
+    // Элементы за пределами возвращённого размера удаляются
+    template <typename Operation>
+    void ResizeAndOverwrite(size_t count, Operation op);
+
+    // Удаляет все элементы, ёмкость не меняется
+    VECTOR_CONSTEXPR void Clear() noexcept;
+    // Удаляет все элементы в нескольких потоках (например, перед разрушением большого вектора)
+    void Clear(ParallelTag tag) noexcept;
+    // Уменьшает ёмкость до размера вектора. Как и Reserve, даёт строгую гарантию безопасности исключений
+    VECTOR_CONSTEXPR void ShrinkToFit();
+    // Уменьшает ёмкость до размера вектора, если доля неиспользуемой ёмкости превышает ratio.
+    // Возвращает true, если память была перераспределена
+    bool ShrinkIfWasteAbove(double ratio);
 
     template <typename... Args>
-    T& EmplaceBack(Args&&... args);
-    T& PushBack(const T &value);
-    T& PushBack(T &&value);
-    void PopBack() noexcept;
+    VECTOR_CONSTEXPR T& EmplaceBack(Args&&... args);
+    VECTOR_CONSTEXPR T& PushBack(const T &value);
+    VECTOR_CONSTEXPR T& PushBack(T &&value);
+    VECTOR_CONSTEXPR void PopBack() noexcept;
 
     template <typename... Args>
-    iterator Emplace(const_iterator pos, Args&&... args);
-    iterator Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>);
-    iterator Insert(const_iterator pos, const T &value);
-    iterator Insert(const_iterator pos, T &&value);
-
-    const T& operator[](size_t index) const noexcept;
-    T& operator[](size_t index) noexcept;
+    VECTOR_CONSTEXPR iterator Emplace(const_iterator pos, Args&&... args);
+    VECTOR_CONSTEXPR iterator Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>);
+    // Удаляет элементы [first, last), сдвигая хвост один раз
+    VECTOR_CONSTEXPR iterator Erase(const_iterator first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>);
+    // Удаляют элементы, удовлетворяющие предикату или равные значению, за один проход:
+    // каждый оставшийся элемент перемещается не более одного раза. Возвращают число удалённых элементов
+    template <typename Predicate>
+    VECTOR_CONSTEXPR size_t EraseIf(Predicate pred);
+    VECTOR_CONSTEXPR size_t EraseValue(const T &value);
+    VECTOR_CONSTEXPR iterator Insert(const_iterator pos, const T &value);
+    VECTOR_CONSTEXPR iterator Insert(const_iterator pos, T &&value);
+
+    // Групповая вставка: итоговый размер вычисляется заранее, память перераспределяется
+    // не более одного раза, а хвост сдвигается однократно. Для однопроходных итераторов
+    // элементы добавляются в конец с амортизированным ростом и затем переставляются на место.
+    // Вставляемый диапазон не должен ссылаться на элементы самого вектора
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    iterator Insert(const_iterator pos, InputIt first, InputIt last);
+    iterator Insert(const_iterator pos, size_t count, const T &value);
+    iterator Insert(const_iterator pos, std::initializer_list<T> init);
+    // Добавляет в конец все элементы контейнера range
+    template <typename Range>
+    void Append(const Range &range);
+    // Переносит в конец все элементы other (для тривиально перемещаемых типов - одним memcpy),
+    // other становится пустым, но сохраняет ёмкость
+    void Append(Vector &&other);
+
+    // индекс проверяется в режиме VectorBoundsCheck<T>
+    VECTOR_CONSTEXPR const T& operator[](size_t index) const noexcept(INDEX_NOEXCEPT);
+    VECTOR_CONSTEXPR T& operator[](size_t index) noexcept(INDEX_NOEXCEPT);
+    // элемент с индексом index; выбрасывает std::out_of_range, если index >= Size()
+    VECTOR_CONSTEXPR const T& At(size_t index) const;
+    VECTOR_CONSTEXPR T& At(size_t index);
+
+    // Представления элементов без копирования. Действительны, пока не изменится ёмкость вектора
+    VECTOR_CONSTEXPR Span<T> AsSpan() noexcept;
+    VECTOR_CONSTEXPR Span<const T> AsSpan() const noexcept;
+    // count элементов, начиная с offset
+    VECTOR_CONSTEXPR Span<T> Slice(size_t offset, size_t count) noexcept;
+    VECTOR_CONSTEXPR Span<const T> Slice(size_t offset, size_t count) const noexcept;
 
 private:
-    RawMemory<T> data_;
+    using AllocTraits = std::allocator_traits<Alloc>;
+    // память может быть передана при перемещающем присваивании без поэлементного перемещения
+    static constexpr bool ALLOC_MOVES_MEMORY = AllocTraits::propagate_on_container_move_assignment::value
+                                               || AllocTraits::is_always_equal::value;
+    static constexpr bool INDEX_NOEXCEPT = VectorBoundsCheckV<T> != BoundsCheck::THROW;
+
+    RawMemory<T, Alloc> data_;
     size_t size_ = 0;
 
-    // если move-конструктор не выбрасывает исключений или нет copу-конструктора,
-    // то делаем перемещение, иначе копируем элементы из старой области памяти в новую
-    static void SafeMove(T *from, size_t size, T *to);
+    // переносит элементы в буфер ёмкостью new_capacity: для REALLOCATABLE типов через realloc,
+    // для остальных - через выделение нового буфера и SafeMove
+    VECTOR_CONSTEXPR void Reallocate(size_t new_capacity);
+
+    // ёмкость, до которой по политике роста увеличивается заполненный вектор
+    VECTOR_CONSTEXPR size_t NextCapacity() const noexcept;
+    // передаёт в Capacity() фактический размер выделенного блока, если этого требует политика роста
+    static VECTOR_CONSTEXPR void AdoptUsableSize(RawMemory<T, Alloc> &data) noexcept;
 
     template <typename... Args>
-    iterator EmplaceWithReallocate(const_iterator pos, Args&&... args);
+    VECTOR_CONSTEXPR iterator EmplaceWithReallocate(const_iterator pos, Args&&... args);
 
     template <typename... Args>
-    iterator EmplaceWithoutReallocate(const_iterator pos, Args&&... args);
+    VECTOR_CONSTEXPR iterator EmplaceWithoutReallocate(const_iterator pos, Args&&... args);
+
+    // удаляет элементы начиная с позиции new_size
+    VECTOR_CONSTEXPR void DestroyTail(size_t new_size) noexcept;
+
+    // вставляет count элементов, начиная с first, в позицию index
+    template <typename ForwardIt>
+    iterator InsertForward(size_t index, ForwardIt first, size_t count);
+
+    // копирует элементы other в неинициализированную память вектора в нескольких потоках
+    void ParallelCopyConstruct(ParallelTag tag, const Vector &other);
 
 }; // class Vector
 
-template<typename T>
-typename Vector<T>::iterator Vector<T>::begin() noexcept {
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::begin() noexcept {
     return data_.GetAddress();
 }
 
-template<typename T>
-typename Vector<T>::iterator Vector<T>::end() noexcept {
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::end() noexcept {
     return data_ + size_;
 }
 
-template<typename T>
-typename Vector<T>::const_iterator Vector<T>::begin() const noexcept {
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR typename Vector<T, Alloc, Growth>::const_iterator Vector<T, Alloc, Growth>::begin() const noexcept {
     return data_.GetAddress();
 }
 
-template<typename T>
-typename Vector<T>::const_iterator Vector<T>::end() const noexcept {
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR typename Vector<T, Alloc, Growth>::const_iterator Vector<T, Alloc, Growth>::end() const noexcept {
     return data_ + size_;
 }
 
-template<typename T>
-typename Vector<T>::const_iterator Vector<T>::cbegin() const noexcept {
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR typename Vector<T, Alloc, Growth>::const_iterator Vector<T, Alloc, Growth>::cbegin() const noexcept {
     return data_.GetAddress();
 }
 
-template<typename T>
-typename Vector<T>::const_iterator Vector<T>::cend() const noexcept {
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR typename Vector<T, Alloc, Growth>::const_iterator Vector<T, Alloc, Growth>::cend() const noexcept {
     return data_ + size_;
 }
 
-template<typename T>
-Vector<T>::Vector(size_t size)
-    : data_(size)
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR Vector<T, Alloc, Growth>::Vector(const Alloc &alloc) noexcept
+    : data_(alloc)  //
+{
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR Vector<T, Alloc, Growth>::Vector(size_t size, const Alloc &alloc)
+    : data_(size, alloc)
     , size_(size)  //
 {
-    std::uninitialized_value_construct_n(data_.GetAddress(), size);
+    UninitializedValueConstructN(data_.GetAddress(), size);
+}
+
+template<typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector(size_t size, DefaultInitTag, const Alloc &alloc)
+    : data_(size, alloc)
+    , size_(size)  //
+{
+    std::uninitialized_default_construct_n(data_.GetAddress(), size);
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR Vector<T, Alloc, Growth>::Vector(std::initializer_list<T> init, const Alloc &alloc)
+    : data_(init.size(), alloc)
+    , size_(init.size())  //
+{
+    UninitializedCopyN(init.begin(), size_, data_.GetAddress());
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR Vector<T, Alloc, Growth>::Vector(Span<const T> span, const Alloc &alloc)
+    : data_(span.Size(), alloc)
+    , size_(span.Size())  //
+{
+    UninitializedCopyN(span.Data(), size_, data_.GetAddress());
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR Vector<T, Alloc, Growth>::Vector(const Vector &other)
+    : Vector(other, AllocTraits::select_on_container_copy_construction(other.data_.GetAllocator()))  //
+{
 }
 
-template<typename T>
-Vector<T>::Vector(const Vector &other)
-    : data_(other.size_)
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR Vector<T, Alloc, Growth>::Vector(const Vector &other, const Alloc &alloc)
+    : data_(other.size_, alloc)
     , size_(other.size_)  //
 {
-    std::uninitialized_copy_n(other.data_.GetAddress(), size_, data_.GetAddress());
+    UninitializedCopyN(other.data_.GetAddress(), size_, data_.GetAddress());
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR Vector<T, Alloc, Growth>::Vector(Vector<T, Alloc, Growth> &&other) noexcept
+    : data_(std::move(other.data_))
+    , size_(std::exchange(other.size_, 0))  //
+{
 }
 
-template<typename T>
-Vector<T>::Vector(Vector<T> &&other) noexcept {
-    data_ = std::move(other.data_);
-    size_ = std::exchange(other.size_, 0);
+template<typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector(ParallelTag tag, size_t size, const Alloc &alloc)
+    : data_(size, alloc)  //
+{
+    T *data = data_.GetAddress();
+    ForEachChunk(size, tag.threads, tag.min_chunk, [data](size_t first, size_t last) {
+        std::uninitialized_value_construct(data + first, data + last);
+    }, [data](size_t first, size_t last) {
+        std::destroy(data + first, data + last);
+    });
+    size_ = size;
+}
+
+template<typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector(ParallelTag tag, const Vector &other)
+    : data_(other.size_, AllocTraits::select_on_container_copy_construction(other.data_.GetAllocator()))  //
+{
+    ParallelCopyConstruct(tag, other);
 }
 
-template<typename T>
-Vector<T>& Vector<T>::operator=(const Vector<T> &rhs) {
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR Vector<T, Alloc, Growth>& Vector<T, Alloc, Growth>::operator=(const Vector<T, Alloc, Growth> &rhs) {
     if (this != &rhs) {
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value
+                      && !AllocTraits::is_always_equal::value) {
+            // память, выделенную текущим аллокатором, может освободить только он сам,
+            // поэтому перед сменой аллокатора вектор очищается
+            if (data_.GetAllocator() != rhs.data_.GetAllocator()) {
+                std::destroy_n(data_.GetAddress(), size_);
+                size_ = 0;
+                data_.Reset(rhs.data_.GetAllocator());
+            }
+        }
         if (rhs.size_ > data_.Capacity()) {
-            Vector rhs_copy(rhs);
+            Vector rhs_copy(rhs, data_.GetAllocator());
             Swap(rhs_copy);
         } else {
             /* если в источнике элементов меньше чем в приёмнике,
@@ -258,7 +1604,7 @@ Vector<T>& Vector<T>::operator=(const Vector<T> &rhs) {
             if (rhs.size_ < size_) {
                 std::destroy_n(end, size_ - rhs.size_);
             } else {
-                std::uninitialized_copy_n(rhs.data_.GetAddress() + size_, rhs.size_ - size_, end);
+                UninitializedCopyN(rhs.data_.GetAddress() + size_, rhs.size_ - size_, end);
             }
             size_ = rhs.size_;
         }
@@ -266,89 +1612,195 @@ Vector<T>& Vector<T>::operator=(const Vector<T> &rhs) {
     return *this;
 }
 
-template<typename T>
-Vector<T>& Vector<T>::operator=(Vector<T> &&rhs) noexcept {
-    Swap(rhs);
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR Vector<T, Alloc, Growth>& Vector<T, Alloc, Growth>::operator=(Vector<T, Alloc, Growth> &&rhs) noexcept(ALLOC_MOVES_MEMORY) {
+    if (this == &rhs) {
+        return *this;
+    }
+    if constexpr (!ALLOC_MOVES_MEMORY) {
+        if (data_.GetAllocator() != rhs.data_.GetAllocator()) {
+            Vector rhs_moved(data_.GetAllocator());
+            rhs_moved.Reserve(rhs.size_);
+            UninitializedMoveN(rhs.data_.GetAddress(), rhs.size_, rhs_moved.data_.GetAddress());
+            rhs_moved.size_ = rhs.size_;
+            Swap(rhs_moved);
+            return *this;
+        }
+    }
+    std::destroy_n(data_.GetAddress(), size_);
+    data_ = std::move(rhs.data_);
+    size_ = std::exchange(rhs.size_, 0);
     return *this;
 }
 
-template<typename T>
-Vector<T>::~Vector() {
+template<typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::CopyFrom(ParallelTag tag, const Vector &other) {
+    if (this == &other) {
+        return;
+    }
+    Clear(tag);
+    if constexpr (AllocTraits::propagate_on_container_copy_assignment::value
+                  && !AllocTraits::is_always_equal::value) {
+        if (data_.GetAllocator() != other.data_.GetAllocator()) {
+            data_.Reset(other.data_.GetAllocator());
+        }
+    }
+    Reserve(other.size_);
+    ParallelCopyConstruct(tag, other);
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR Vector<T, Alloc, Growth>::~Vector() {
+    vector_stats::OnRelease<T>(size_, data_.Capacity());
     std::destroy_n(data_.GetAddress(), size_);
 }
 
-template<typename T>
-void Vector<T>::Swap(Vector<T> &other) noexcept {
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR void Vector<T, Alloc, Growth>::Swap(Vector<T, Alloc, Growth> &other) noexcept {
     data_.Swap(other.data_);
     std::swap(size_, other.size_);
 }
 
-template<typename T>
-size_t Vector<T>::Size() const noexcept {
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR typename Vector<T, Alloc, Growth>::allocator_type Vector<T, Alloc, Growth>::GetAllocator() const noexcept {
+    return data_.GetAllocator();
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR size_t Vector<T, Alloc, Growth>::Size() const noexcept {
     return size_;
 }
 
-template<typename T>
-size_t Vector<T>::Capacity() const noexcept {
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR size_t Vector<T, Alloc, Growth>::Capacity() const noexcept {
     return data_.Capacity();
 }
 
-template<typename T>
-void Vector<T>::Reserve(size_t new_capacity) {
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR void Vector<T, Alloc, Growth>::Reserve(size_t new_capacity) {
     if (new_capacity <= data_.Capacity()) {
         return;
     }
-    RawMemory<T> new_data{new_capacity};
-    SafeMove(data_.GetAddress(), size_, new_data.GetAddress());
-    data_.Swap(new_data);
+    Reallocate(new_capacity);
 }
 
-template<typename T>
-void Vector<T>::Resize(size_t new_size) {
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR void Vector<T, Alloc, Growth>::Resize(size_t new_size) {
     if (new_size < size_) {
         std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
     } else if (new_size > size_) {
         Reserve(new_size);
-        std::uninitialized_value_construct_n(data_.GetAddress() + size_, new_size - size_);
+        UninitializedValueConstructN(data_.GetAddress() + size_, new_size - size_);
     }
     size_ = new_size;
 }
 
-template<typename T>
-T& Vector<T>::PushBack(const T &value) {
+template<typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::ResizeForOverwrite(size_t new_size) {
+    if (new_size < size_) {
+        DestroyTail(new_size);
+    } else if (new_size > size_) {
+        Reserve(new_size);
+        std::uninitialized_default_construct_n(data_.GetAddress() + size_, new_size - size_);
+        size_ = new_size;
+    }
+}
+
+template<typename T, typename Alloc, typename Growth>
+template <typename Operation>
+void Vector<T, Alloc, Growth>::ResizeAndOverwrite(size_t count, Operation op) {
+    if (count > size_) {
+        ResizeForOverwrite(count);
+    }
+    const size_t new_size = static_cast<size_t>(op(data_.GetAddress(), count));
+    assert(new_size <= count);
+    DestroyTail(new_size);
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR void Vector<T, Alloc, Growth>::Clear() noexcept {
+    DestroyTail(0);
+}
+
+template<typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::Clear(ParallelTag tag) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        T *data = data_.GetAddress();
+        auto destroy = [data](size_t first, size_t last) {
+            std::destroy(data + first, data + last);
+        };
+        ForEachChunk(size_, tag.threads, tag.min_chunk, destroy, destroy);
+    }
+    size_ = 0;
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR void Vector<T, Alloc, Growth>::ShrinkToFit() {
+    if (size_ < data_.Capacity()) {
+        Reallocate(size_);
+    }
+}
+
+template<typename T, typename Alloc, typename Growth>
+bool Vector<T, Alloc, Growth>::ShrinkIfWasteAbove(double ratio) {
+    const size_t capacity = data_.Capacity();
+    const size_t waste = capacity - size_;
+    if (waste == 0 || static_cast<double>(waste) <= ratio * static_cast<double>(capacity)) {
+        return false;
+    }
+    ShrinkToFit();
+    return data_.Capacity() < capacity;
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR T& Vector<T, Alloc, Growth>::PushBack(const T &value) {
     return EmplaceBack(value);
 }
 
-template<typename T>
-T& Vector<T>::PushBack(T &&value) {
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR T& Vector<T, Alloc, Growth>::PushBack(T &&value) {
     return EmplaceBack(std::move(value));
 }
 
-template<typename T>
-void Vector<T>::PopBack() noexcept {
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR void Vector<T, Alloc, Growth>::PopBack() noexcept {
     assert(size_ > 0);
     std::destroy_at(data_+(size_-1));
     --size_;
 }
 
-template<typename T>
+template<typename T, typename Alloc, typename Growth>
 template<typename... Args>
-T& Vector<T>::EmplaceBack(Args&&... args) {
-    if (size_ == Capacity()) {
-        RawMemory<T> new_data{size_ == 0 ? 1 : size_ * 2};
-        new (new_data + size_) T(std::forward<Args>(args)...);
-        SafeMove(data_.GetAddress(), size_, new_data.GetAddress());
-        data_.Swap(new_data);
-    } else {
-        new (data_ + size_) T(std::forward<Args>(args)...);
+VECTOR_CONSTEXPR T& Vector<T, Alloc, Growth>::EmplaceBack(Args&&... args) {
+    if (size_ < Capacity()) {
+        ConstructAt(data_ + size_, std::forward<Args>(args)...);
+        ++size_;
+        return data_[size_ - 1];
+    }
+    if constexpr (RawMemory<T, Alloc>::REALLOCATABLE) {
+        // realloc недоступен при вычислении константного выражения
+        if (!IsConstantEvaluated()) {
+            // аргументы могут ссылаться на элементы вектора, а realloc может освободить старый буфер,
+            // поэтому элемент создаётся до реаллокации
+            T temp(std::forward<Args>(args)...);
+            data_.Reallocate(NextCapacity());
+            AdoptUsableSize(data_);
+            ConstructAt(data_ + size_, std::move(temp));
+            ++size_;
+            return data_[size_ - 1];
+        }
     }
+    RawMemory<T, Alloc> new_data{NextCapacity(), data_.GetAllocator()};
+    AdoptUsableSize(new_data);
+    RelocateWithEmplace(data_.GetAddress(), size_, new_data.GetAddress(), size_, std::forward<Args>(args)...);
+    data_.Swap(new_data);
     ++size_;
     return data_[size_ - 1];
 }
 
-template<typename T>
+template<typename T, typename Alloc, typename Growth>
 template<typename... Args>
-typename Vector<T>::iterator Vector<T>::Emplace(const_iterator pos, Args&&... args) {
+VECTOR_CONSTEXPR typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::Emplace(const_iterator pos, Args&&... args) {
     if (pos == end()) {
         return &EmplaceBack(std::forward<Args>(args)...);
     }
@@ -360,92 +1812,298 @@ typename Vector<T>::iterator Vector<T>::Emplace(const_iterator pos, Args&&... ar
 
 }
 
-template<typename T>
-typename Vector<T>::iterator Vector<T>::Insert(const_iterator pos, const T &value) {
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::Insert(const_iterator pos, const T &value) {
     return Emplace(pos, value);
 }
 
-template<typename T>
-typename Vector<T>::iterator Vector<T>::Insert(const_iterator pos, T &&value) {
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::Insert(const_iterator pos, T &&value) {
     return Emplace(pos, std::move(value));
 }
 
-template<typename T>
-typename Vector<T>::iterator Vector<T>::Erase(const_iterator pos)
+template<typename T, typename Alloc, typename Growth>
+template <typename InputIt, typename>
+typename Vector<T, Alloc, Growth>::iterator
+Vector<T, Alloc, Growth>::Insert(const_iterator pos, InputIt first, InputIt last) {
+    assert(pos >= begin() && pos <= end());
+    const size_t index = static_cast<size_t>(pos - begin());
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_convertible_v<Category, std::forward_iterator_tag>) {
+        return InsertForward(index, first, static_cast<size_t>(std::distance(first, last)));
+    } else {
+        const size_t old_size = size_;
+        for (; first != last; ++first) {
+            EmplaceBack(*first);
+        }
+        std::rotate(begin() + index, begin() + old_size, end());
+        return begin() + index;
+    }
+}
+
+template<typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::iterator
+Vector<T, Alloc, Growth>::Insert(const_iterator pos, size_t count, const T &value) {
+    assert(pos >= begin() && pos <= end());
+    const size_t index = static_cast<size_t>(pos - begin());
+    if (count == 0) {
+        return begin() + index;
+    }
+    // value может ссылаться на элемент вектора, поэтому вставляется его копия
+    const T temp(value);
+    return InsertForward(index, RepeatIterator<T>(temp, 0), count);
+}
+
+template<typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::iterator
+Vector<T, Alloc, Growth>::Insert(const_iterator pos, std::initializer_list<T> init) {
+    return Insert(pos, init.begin(), init.end());
+}
+
+template<typename T, typename Alloc, typename Growth>
+template <typename Range>
+void Vector<T, Alloc, Growth>::Append(const Range &range) {
+    Insert(cend(), std::begin(range), std::end(range));
+}
+
+template<typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::Append(Vector &&other) {
+    if (this == &other || other.size_ == 0) {
+        return;
+    }
+    const size_t new_size = size_ + other.size_;
+    if (new_size > Capacity()) {
+        Reallocate(Growth::NextCapacity(Capacity(), new_size, sizeof(T)));
+    }
+    SafeMove(other.data_.GetAddress(), other.size_, data_ + size_);
+    size_ = new_size;
+    other.size_ = 0;
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::Erase(const_iterator pos)
 noexcept(std::is_nothrow_move_assignable_v<T>) {
     assert(size_ > 0);
-    size_t index = static_cast<size_t>(pos - begin());
-    std::move(begin() + index + 1, end(), begin() + index);
-    data_[size_ - 1].~T();
-    --size_;
+    return Erase(pos, pos + 1);
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR typename Vector<T, Alloc, Growth>::iterator
+Vector<T, Alloc, Growth>::Erase(const_iterator first, const_iterator last)
+noexcept(std::is_nothrow_move_assignable_v<T>) {
+    assert(begin() <= first && first <= last && last <= end());
+    const size_t index = static_cast<size_t>(first - begin());
+    const size_t count = static_cast<size_t>(last - first);
+    if (count == 0) {
+        return begin() + index;
+    }
+    if constexpr (IsTriviallyRelocatableV<T>) {
+        if (!IsConstantEvaluated()) {
+            // удалённые элементы разрушаются, а хвост переносится на их место побайтово
+            std::destroy_n(begin() + index, count);
+            std::memmove(static_cast<void*>(begin() + index), static_cast<const void*>(begin() + index + count),
+                         (size_ - index - count) * sizeof(T));
+            size_ -= count;
+            return begin() + index;
+        }
+    }
+    std::move(begin() + index + count, end(), begin() + index);
+    DestroyTail(size_ - count);
     return begin() + index;
 }
 
-template<typename T>
-const T& Vector<T>::operator[](size_t index) const noexcept {
+template<typename T, typename Alloc, typename Growth>
+template <typename Predicate>
+VECTOR_CONSTEXPR size_t Vector<T, Alloc, Growth>::EraseIf(Predicate pred) {
+    const size_t new_size = static_cast<size_t>(std::remove_if(begin(), end(), pred) - begin());
+    const size_t removed = size_ - new_size;
+    DestroyTail(new_size);
+    return removed;
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR size_t Vector<T, Alloc, Growth>::EraseValue(const T &value) {
+    [[maybe_unused]] const bool aliases_element = std::less_equal<const T*>()(cbegin(), &value) && std::less<const T*>()(&value, cend());
+    if constexpr (std::is_copy_constructible_v<T>) {
+        // элемент-образец может быть перезаписан при сдвиге, поэтому сравниваем с его копией
+        if (aliases_element) {
+            const T copy(value);
+            return EraseIf([&copy](const T &elem) {
+                return elem == copy;
+            });
+        }
+    } else {
+        assert(!aliases_element);
+    }
+    return EraseIf([&value](const T &elem) {
+        return elem == value;
+    });
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR const T& Vector<T, Alloc, Growth>::operator[](size_t index) const noexcept(INDEX_NOEXCEPT) {
     return const_cast<Vector&>(*this)[index];
 }
 
-template<typename T>
-T& Vector<T>::operator[](size_t index) noexcept {
-    assert(index < size_);
-    return data_[index];
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR T& Vector<T, Alloc, Growth>::operator[](size_t index) noexcept(INDEX_NOEXCEPT) {
+    vector_bounds::CheckIndex<VectorBoundsCheckV<T>>(index, size_);
+    // индекс меньше размера, поэтому проверка ёмкости в RawMemory не нужна
+    return data_.GetAddress()[index];
 }
 
-template<typename T>
-void Vector<T>::SafeMove(T *from, size_t size, T *to) {
-    if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-        std::uninitialized_move_n(from, size, to);
-    } else {
-        std::uninitialized_copy_n(from, size, to);
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR const T& Vector<T, Alloc, Growth>::At(size_t index) const {
+    return const_cast<Vector&>(*this).At(index);
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR T& Vector<T, Alloc, Growth>::At(size_t index) {
+    vector_bounds::CheckIndex<BoundsCheck::THROW>(index, size_);
+    return data_.GetAddress()[index];
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR Span<T> Vector<T, Alloc, Growth>::AsSpan() noexcept {
+    return {data_.GetAddress(), size_};
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR Span<const T> Vector<T, Alloc, Growth>::AsSpan() const noexcept {
+    return {data_.GetAddress(), size_};
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR Span<T> Vector<T, Alloc, Growth>::Slice(size_t offset, size_t count) noexcept {
+    return AsSpan().Slice(offset, count);
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR Span<const T> Vector<T, Alloc, Growth>::Slice(size_t offset, size_t count) const noexcept {
+    return AsSpan().Slice(offset, count);
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR void Vector<T, Alloc, Growth>::Reallocate(size_t new_capacity) {
+    if constexpr (RawMemory<T, Alloc>::REALLOCATABLE) {
+        if (!IsConstantEvaluated()) {
+            data_.Reallocate(new_capacity);
+            AdoptUsableSize(data_);
+            return;
+        }
     }
-    std::destroy_n(from, size);
+    RawMemory<T, Alloc> new_data{new_capacity, data_.GetAllocator()};
+    AdoptUsableSize(new_data);
+    SafeMove(data_.GetAddress(), size_, new_data.GetAddress());
+    data_.Swap(new_data);
 }
 
-template<typename T>
-template <typename... Args>
-typename Vector<T>::iterator
-Vector<T>::EmplaceWithReallocate(const_iterator pos, Args&&... args) {
-    size_t index = static_cast<size_t>(pos - begin());
-    RawMemory<T> new_data{size_ == 0 ? 1 : size_ * 2};
-    new (new_data + index) T(std::forward<Args>(args)...);
-    try {
-        SafeMove(data_.GetAddress(), index, new_data.GetAddress());
-    }  catch (...) {
-        new_data[index].~T();
-        throw;
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR void Vector<T, Alloc, Growth>::DestroyTail(size_t new_size) noexcept {
+    assert(new_size <= size_);
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
     }
+    size_ = new_size;
+}
 
-    try {
-        SafeMove(data_+index, size_ - index, new_data + (index+1));
-    }  catch (...) {
-        std::destroy_n(new_data.GetAddress(), index + 1);
-        throw;
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR size_t Vector<T, Alloc, Growth>::NextCapacity() const noexcept {
+    return Growth::NextCapacity(Capacity(), size_ + 1, sizeof(T));
+}
+
+template<typename T, typename Alloc, typename Growth>
+VECTOR_CONSTEXPR void Vector<T, Alloc, Growth>::AdoptUsableSize(RawMemory<T, Alloc> &data) noexcept {
+    if constexpr (Growth::USE_USABLE_SIZE) {
+        if (!IsConstantEvaluated()) {
+            data.ExtendToUsableSize();
+        }
     }
-    data_.Swap(new_data);
+}
 
+template<typename T, typename Alloc, typename Growth>
+template <typename... Args>
+VECTOR_CONSTEXPR typename Vector<T, Alloc, Growth>::iterator
+Vector<T, Alloc, Growth>::EmplaceWithReallocate(const_iterator pos, Args&&... args) {
+    size_t index = static_cast<size_t>(pos - begin());
+    if constexpr (RawMemory<T, Alloc>::REALLOCATABLE) {
+        if (!IsConstantEvaluated()) {
+            if constexpr (std::is_nothrow_constructible_v<T, Args...>) {
+                // если аргументы не ссылаются на элементы, которые realloc может освободить,
+                // элемент создаётся сразу на своём месте
+                if (NoneAliases(cbegin(), cend(), args...)) {
+                    data_.Reallocate(NextCapacity());
+                    AdoptUsableSize(data_);
+                    ShiftTailBytewise(data_.GetAddress(), size_, index);
+                    ConstructAt(data_ + index, std::forward<Args>(args)...);
+                    ++size_;
+                    return begin() + index;
+                }
+            }
+            T temp(std::forward<Args>(args)...);
+            data_.Reallocate(NextCapacity());
+            AdoptUsableSize(data_);
+            // сдвигаем хвост на одну позицию вправо побайтово
+            ShiftTailBytewise(data_.GetAddress(), size_, index);
+            ConstructAt(data_ + index, std::move(temp));
+            ++size_;
+            return begin() + index;
+        }
+    }
+    RawMemory<T, Alloc> new_data{NextCapacity(), data_.GetAllocator()};
+    AdoptUsableSize(new_data);
+    RelocateWithEmplace(data_.GetAddress(), size_, new_data.GetAddress(), index, std::forward<Args>(args)...);
+    data_.Swap(new_data);
     ++size_;
     return begin() + index;
 }
 
-template<typename T>
+template<typename T, typename Alloc, typename Growth>
 template <typename... Args>
-typename Vector<T>::iterator
-Vector<T>::EmplaceWithoutReallocate(const_iterator pos, Args&&... args) {
+VECTOR_CONSTEXPR typename Vector<T, Alloc, Growth>::iterator
+Vector<T, Alloc, Growth>::EmplaceWithoutReallocate(const_iterator pos, Args&&... args) {
     size_t index = static_cast<size_t>(pos - begin());
-    T temp(std::forward<Args>(args)...);
-    // память после последнего элемента - не инициализирована, поэтому инициализируем её размещающим new
-    // остальные элементы переносим на один вправо
-    new (end()) T(std::move(data_[size_ - 1]));
-    std::move_backward(begin() + index, end() - 1, end());
-    data_[index] = std::move(temp);
-
+    EmplaceShifted(data_.GetAddress(), size_, index, std::forward<Args>(args)...);
     ++size_;
     return begin() + index;
 }
 
-template<typename T>
-std::ostream& operator<<(std::ostream &out, const Vector<T> &vector) {
+template<typename T, typename Alloc, typename Growth>
+template <typename ForwardIt>
+typename Vector<T, Alloc, Growth>::iterator
+Vector<T, Alloc, Growth>::InsertForward(size_t index, ForwardIt first, size_t count) {
+    if (count == 0) {
+        return begin() + index;
+    }
+    if (size_ + count > Capacity()) {
+        RawMemory<T, Alloc> new_data{Growth::NextCapacity(Capacity(), size_ + count, sizeof(T)), data_.GetAllocator()};
+        AdoptUsableSize(new_data);
+        RelocateWithGap(data_.GetAddress(), size_, new_data.GetAddress(), index, count, [&](T *gap) {
+            std::uninitialized_copy_n(first, count, gap);
+        });
+        data_.Swap(new_data);
+    } else {
+        InsertShifted(data_.GetAddress(), size_, index, first, count);
+    }
+    size_ += count;
+    return begin() + index;
+}
+
+template<typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::ParallelCopyConstruct(ParallelTag tag, const Vector &other) {
+    assert(size_ == 0 && data_.Capacity() >= other.size_);
+    T *data = data_.GetAddress();
+    const T *source = other.data_.GetAddress();
+    ForEachChunk(other.size_, tag.threads, tag.min_chunk, [data, source](size_t first, size_t last) {
+        std::uninitialized_copy(source + first, source + last, data + first);
+    }, [data](size_t first, size_t last) {
+        std::destroy(data + first, data + last);
+    });
+    size_ = other.size_;
+}
+
+template<typename T, typename Alloc, typename Growth>
+std::ostream& operator<<(std::ostream &out, const Vector<T, Alloc, Growth> &vector) {
     out << "[ ";
     for (const auto &elem : vector) {
         out << elem << " ";
@@ -453,3 +2111,16 @@ std::ostream& operator<<(std::ostream &out, const Vector<T> &vector) {
     out << "]\n";
     return out;
 }
+
+namespace pmr {
+
+// Вектор, память под который выделяется из std::pmr::memory_resource
+// (например, из std::pmr::monotonic_buffer_resource, освобождаемого целиком)
+template <typename T, typename Growth = DoublingGrowth>
+using Vector = ::Vector<T, std::pmr::polymorphic_allocator<T>, Growth>;
+
+} // namespace pmr
+
+// Вектор с буфером, выровненным по границе ALIGNMENT байт
+template <typename T, size_t ALIGNMENT = CACHE_LINE_SIZE, typename Growth = DoublingGrowth>
+using AlignedVector = Vector<T, AlignedAllocator<T, ALIGNMENT>, Growth>;
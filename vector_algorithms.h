@@ -0,0 +1,720 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define VECTOR_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define VECTOR_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// ------------------------------- SIMD ALGORITHMS --------------------------------------
+
+/* Групповые операции над непрерывными массивами (в том числе над элементами Vector).
+   Для int32_t и float используются векторные реализации, выбираемые во время выполнения
+   по возможностям процессора (AVX-512F, AVX2 + FMA на x86, NEON на AArch64), для остальных
+   типов и процессоров без этих расширений - скалярные циклы.
+   Ядра используют невыровненные загрузки: буферы Vector со стандартным аллокатором выровнены
+   только по alignof(T), а на процессорах с AVX2 невыровненная загрузка выровненных данных
+   (например, из AlignedVector) не медленнее выровненной.
+   Порядок суммирования float в векторных реализациях отличается от последовательного,
+   поэтому результат Sum и Dot может отличаться от скалярного в пределах ошибки округления.
+   MinMax для float не допускает NaN среди элементов */
+
+namespace simd {
+
+enum class Isa {
+    SCALAR,
+    NEON,
+    AVX2,
+    AVX512,
+};
+
+// типы, для которых есть векторные реализации
+template <typename T>
+inline constexpr bool IS_VECTORIZABLE = std::is_same_v<T, int32_t> || std::is_same_v<T, float>;
+
+// тип результата Sum и Dot: сумма int32_t накапливается в int64_t
+template <typename T>
+using SumType = std::conditional_t<std::is_same_v<T, int32_t>, int64_t, T>;
+
+// лучший набор инструкций, поддерживаемый процессором
+Isa SupportedIsa() noexcept;
+// набор инструкций, используемый функциями модуля
+Isa CurrentIsa() noexcept;
+// ограничивает используемый набор инструкций (не выше поддерживаемого), например,
+// для сравнения векторной реализации со скалярной
+void SetIsa(Isa isa) noexcept;
+
+template <typename T>
+void Fill(T *first, size_t count, const T &value);
+// индекс первого элемента, равного value, либо count, если такого нет
+template <typename T>
+size_t Find(const T *first, size_t count, const T &value);
+template <typename T>
+size_t Count(const T *first, size_t count, const T &value);
+// наименьший и наибольший элементы непустого массива
+template <typename T>
+std::pair<T, T> MinMax(const T *first, size_t count);
+template <typename T>
+SumType<T> Sum(const T *first, size_t count);
+template <typename T>
+SumType<T> Dot(const T *lhs, const T *rhs, size_t count);
+// out[i] = op(in[i]); out может совпадать с in. Простой цикл по указателям без зависимостей
+// между итерациями векторизуется компилятором
+template <typename T, typename U, typename Operation>
+void Transform(const T *in, size_t count, U *out, Operation op);
+
+template <typename T, typename Alloc, typename Growth>
+void Fill(Vector<T, Alloc, Growth> &vector, const T &value);
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::iterator Find(Vector<T, Alloc, Growth> &vector, const T &value);
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::const_iterator Find(const Vector<T, Alloc, Growth> &vector, const T &value);
+template <typename T, typename Alloc, typename Growth>
+size_t Count(const Vector<T, Alloc, Growth> &vector, const T &value);
+template <typename T, typename Alloc, typename Growth>
+std::pair<T, T> MinMax(const Vector<T, Alloc, Growth> &vector);
+template <typename T, typename Alloc, typename Growth>
+SumType<T> Sum(const Vector<T, Alloc, Growth> &vector);
+template <typename T, typename Alloc, typename Growth>
+SumType<T> Dot(const Vector<T, Alloc, Growth> &lhs, const Vector<T, Alloc, Growth> &rhs);
+// применяет op ко всем элементам вектора на месте
+template <typename T, typename Alloc, typename Growth, typename Operation>
+void Transform(Vector<T, Alloc, Growth> &vector, Operation op);
+
+} // namespace simd
+
+namespace {
+
+// ------------------------------------ SCALAR ------------------------------------------
+
+template <typename T>
+void FillScalar(T *first, size_t count, const T &value) {
+    std::fill_n(first, count, value);
+}
+
+template <typename T>
+size_t FindScalar(const T *first, size_t count, const T &value) {
+    return static_cast<size_t>(std::find(first, first + count, value) - first);
+}
+
+template <typename T>
+size_t CountScalar(const T *first, size_t count, const T &value) {
+    return static_cast<size_t>(std::count(first, first + count, value));
+}
+
+template <typename T>
+std::pair<T, T> MinMaxScalar(const T *first, size_t count) {
+    std::pair<T, T> result(first[0], first[0]);
+    for (size_t i = 1; i < count; ++i) {
+        if (first[i] < result.first) {
+            result.first = first[i];
+        }
+        if (result.second < first[i]) {
+            result.second = first[i];
+        }
+    }
+    return result;
+}
+
+template <typename T>
+simd::SumType<T> SumScalar(const T *first, size_t count) {
+    simd::SumType<T> sum{};
+    for (size_t i = 0; i < count; ++i) {
+        sum += first[i];
+    }
+    return sum;
+}
+
+template <typename T>
+simd::SumType<T> DotScalar(const T *lhs, const T *rhs, size_t count) {
+    simd::SumType<T> sum{};
+    for (size_t i = 0; i < count; ++i) {
+        sum += static_cast<simd::SumType<T>>(lhs[i]) * static_cast<simd::SumType<T>>(rhs[i]);
+    }
+    return sum;
+}
+
+#if defined(VECTOR_SIMD_X86)
+
+// ------------------------------------- AVX2 -------------------------------------------
+
+template <typename T>
+__attribute__((target("avx2,fma"))) void FillAvx2(T *first, size_t count, T value) {
+    size_t i = 0;
+    if constexpr (std::is_same_v<T, float>) {
+        const __m256 v = _mm256_set1_ps(value);
+        for (; i + 8 <= count; i += 8) {
+            _mm256_storeu_ps(first + i, v);
+        }
+    } else {
+        const __m256i v = _mm256_set1_epi32(value);
+        for (; i + 8 <= count; i += 8) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(first + i), v);
+        }
+    }
+    FillScalar(first + i, count - i, value);
+}
+
+// маска равенства восьми элементов value, по биту на элемент
+template <typename T>
+__attribute__((target("avx2,fma"))) unsigned EqualMaskAvx2(const T *first, T value) {
+    if constexpr (std::is_same_v<T, float>) {
+        const __m256 eq = _mm256_cmp_ps(_mm256_loadu_ps(first), _mm256_set1_ps(value), _CMP_EQ_OQ);
+        return static_cast<unsigned>(_mm256_movemask_ps(eq));
+    } else {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        const __m256i eq = _mm256_cmpeq_epi32(v, _mm256_set1_epi32(value));
+        return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+    }
+}
+
+template <typename T>
+__attribute__((target("avx2,fma"))) size_t FindAvx2(const T *first, size_t count, T value) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        if (const unsigned mask = EqualMaskAvx2(first + i, value)) {
+            return i + static_cast<size_t>(__builtin_ctz(mask));
+        }
+    }
+    return i + FindScalar(first + i, count - i, value);
+}
+
+template <typename T>
+__attribute__((target("avx2,fma"))) size_t CountAvx2(const T *first, size_t count, T value) {
+    size_t i = 0;
+    size_t result = 0;
+    for (; i + 8 <= count; i += 8) {
+        result += static_cast<size_t>(__builtin_popcount(EqualMaskAvx2(first + i, value)));
+    }
+    return result + CountScalar(first + i, count - i, value);
+}
+
+template <typename T>
+__attribute__((target("avx2,fma"))) std::pair<T, T> MinMaxAvx2(const T *first, size_t count) {
+    if (count < 8) {
+        return MinMaxScalar(first, count);
+    }
+    alignas(32) T lanes[16];
+    size_t i = 8;
+    if constexpr (std::is_same_v<T, float>) {
+        __m256 min = _mm256_loadu_ps(first);
+        __m256 max = min;
+        for (; i + 8 <= count; i += 8) {
+            const __m256 v = _mm256_loadu_ps(first + i);
+            min = _mm256_min_ps(min, v);
+            max = _mm256_max_ps(max, v);
+        }
+        _mm256_store_ps(lanes, min);
+        _mm256_store_ps(lanes + 8, max);
+    } else {
+        __m256i min = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        __m256i max = min;
+        for (; i + 8 <= count; i += 8) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+            min = _mm256_min_epi32(min, v);
+            max = _mm256_max_epi32(max, v);
+        }
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), min);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes + 8), max);
+    }
+    std::pair<T, T> result(MinMaxScalar(lanes, 8).first, MinMaxScalar(lanes + 8, 8).second);
+    if (i < count) {
+        const auto tail = MinMaxScalar(first + i, count - i);
+        result.first = std::min(result.first, tail.first);
+        result.second = std::max(result.second, tail.second);
+    }
+    return result;
+}
+
+template <typename T>
+__attribute__((target("avx2,fma"))) simd::SumType<T> SumAvx2(const T *first, size_t count) {
+    size_t i = 0;
+    simd::SumType<T> sum{};
+    if constexpr (std::is_same_v<T, float>) {
+        __m256 acc = _mm256_setzero_ps();
+        for (; i + 8 <= count; i += 8) {
+            acc = _mm256_add_ps(acc, _mm256_loadu_ps(first + i));
+        }
+        alignas(32) float lanes[8];
+        _mm256_store_ps(lanes, acc);
+        sum = SumScalar(lanes, 8);
+    } else {
+        __m256i acc = _mm256_setzero_si256();
+        for (; i + 8 <= count; i += 8) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+            acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+            acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+        }
+        alignas(32) int64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        sum = SumScalar(lanes, 4);
+    }
+    return sum + SumScalar(first + i, count - i);
+}
+
+__attribute__((target("avx2,fma"))) inline float DotAvx2(const float *lhs, const float *rhs, size_t count) {
+    size_t i = 0;
+    __m256 acc = _mm256_setzero_ps();
+    for (; i + 8 <= count; i += 8) {
+        acc = _mm256_fmadd_ps(_mm256_loadu_ps(lhs + i), _mm256_loadu_ps(rhs + i), acc);
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, acc);
+    return SumScalar(lanes, 8) + DotScalar(lhs + i, rhs + i, count - i);
+}
+
+// ----------------------------------- AVX-512 ------------------------------------------
+
+// интринсики AVX-512 в GCC используют намеренно неинициализированные значения (_mm512_undefined_*),
+// на которые срабатывают -Wuninitialized и -Wmaybe-uninitialized после встраивания
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+
+template <typename T>
+__attribute__((target("avx512f"))) void FillAvx512(T *first, size_t count, T value) {
+    size_t i = 0;
+    if constexpr (std::is_same_v<T, float>) {
+        const __m512 v = _mm512_set1_ps(value);
+        for (; i + 16 <= count; i += 16) {
+            _mm512_storeu_ps(first + i, v);
+        }
+    } else {
+        const __m512i v = _mm512_set1_epi32(value);
+        for (; i + 16 <= count; i += 16) {
+            _mm512_storeu_si512(first + i, v);
+        }
+    }
+    FillScalar(first + i, count - i, value);
+}
+
+// маска равенства шестнадцати элементов value, по биту на элемент
+template <typename T>
+__attribute__((target("avx512f"))) unsigned EqualMaskAvx512(const T *first, T value) {
+    if constexpr (std::is_same_v<T, float>) {
+        return _mm512_cmp_ps_mask(_mm512_loadu_ps(first), _mm512_set1_ps(value), _CMP_EQ_OQ);
+    } else {
+        return _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(first), _mm512_set1_epi32(value));
+    }
+}
+
+template <typename T>
+__attribute__((target("avx512f"))) size_t FindAvx512(const T *first, size_t count, T value) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        if (const unsigned mask = EqualMaskAvx512(first + i, value)) {
+            return i + static_cast<size_t>(__builtin_ctz(mask));
+        }
+    }
+    return i + FindScalar(first + i, count - i, value);
+}
+
+template <typename T>
+__attribute__((target("avx512f"))) size_t CountAvx512(const T *first, size_t count, T value) {
+    size_t i = 0;
+    size_t result = 0;
+    for (; i + 16 <= count; i += 16) {
+        result += static_cast<size_t>(__builtin_popcount(EqualMaskAvx512(first + i, value)));
+    }
+    return result + CountScalar(first + i, count - i, value);
+}
+
+template <typename T>
+__attribute__((target("avx512f"))) std::pair<T, T> MinMaxAvx512(const T *first, size_t count) {
+    if (count < 16) {
+        return MinMaxScalar(first, count);
+    }
+    size_t i = 16;
+    std::pair<T, T> result;
+    if constexpr (std::is_same_v<T, float>) {
+        __m512 min = _mm512_loadu_ps(first);
+        __m512 max = min;
+        for (; i + 16 <= count; i += 16) {
+            const __m512 v = _mm512_loadu_ps(first + i);
+            min = _mm512_min_ps(min, v);
+            max = _mm512_max_ps(max, v);
+        }
+        result = {_mm512_reduce_min_ps(min), _mm512_reduce_max_ps(max)};
+    } else {
+        __m512i min = _mm512_loadu_si512(first);
+        __m512i max = min;
+        for (; i + 16 <= count; i += 16) {
+            const __m512i v = _mm512_loadu_si512(first + i);
+            min = _mm512_min_epi32(min, v);
+            max = _mm512_max_epi32(max, v);
+        }
+        result = {_mm512_reduce_min_epi32(min), _mm512_reduce_max_epi32(max)};
+    }
+    if (i < count) {
+        const auto tail = MinMaxScalar(first + i, count - i);
+        result.first = std::min(result.first, tail.first);
+        result.second = std::max(result.second, tail.second);
+    }
+    return result;
+}
+
+template <typename T>
+__attribute__((target("avx512f"))) simd::SumType<T> SumAvx512(const T *first, size_t count) {
+    size_t i = 0;
+    simd::SumType<T> sum{};
+    if constexpr (std::is_same_v<T, float>) {
+        __m512 acc = _mm512_setzero_ps();
+        for (; i + 16 <= count; i += 16) {
+            acc = _mm512_add_ps(acc, _mm512_loadu_ps(first + i));
+        }
+        sum = _mm512_reduce_add_ps(acc);
+    } else {
+        __m512i acc = _mm512_setzero_si512();
+        for (; i + 16 <= count; i += 16) {
+            const __m512i v = _mm512_loadu_si512(first + i);
+            acc = _mm512_add_epi64(acc, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(v)));
+            acc = _mm512_add_epi64(acc, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(v, 1)));
+        }
+        sum = _mm512_reduce_add_epi64(acc);
+    }
+    return sum + SumScalar(first + i, count - i);
+}
+
+__attribute__((target("avx512f"))) inline float DotAvx512(const float *lhs, const float *rhs, size_t count) {
+    size_t i = 0;
+    __m512 acc = _mm512_setzero_ps();
+    for (; i + 16 <= count; i += 16) {
+        acc = _mm512_fmadd_ps(_mm512_loadu_ps(lhs + i), _mm512_loadu_ps(rhs + i), acc);
+    }
+    return _mm512_reduce_add_ps(acc) + DotScalar(lhs + i, rhs + i, count - i);
+}
+
+#pragma GCC diagnostic pop
+
+#elif defined(VECTOR_SIMD_NEON)
+
+// ------------------------------------- NEON -------------------------------------------
+
+template <typename T>
+void FillNeon(T *first, size_t count, T value) {
+    size_t i = 0;
+    if constexpr (std::is_same_v<T, float>) {
+        const float32x4_t v = vdupq_n_f32(value);
+        for (; i + 4 <= count; i += 4) {
+            vst1q_f32(first + i, v);
+        }
+    } else {
+        const int32x4_t v = vdupq_n_s32(value);
+        for (; i + 4 <= count; i += 4) {
+            vst1q_s32(first + i, v);
+        }
+    }
+    FillScalar(first + i, count - i, value);
+}
+
+// маска равенства четырёх элементов value, по 0xFFFFFFFF на совпавший элемент
+template <typename T>
+uint32x4_t EqualMaskNeon(const T *first, T value) {
+    if constexpr (std::is_same_v<T, float>) {
+        return vceqq_f32(vld1q_f32(first), vdupq_n_f32(value));
+    } else {
+        return vceqq_s32(vld1q_s32(first), vdupq_n_s32(value));
+    }
+}
+
+template <typename T>
+size_t FindNeon(const T *first, size_t count, T value) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        if (vmaxvq_u32(EqualMaskNeon(first + i, value)) != 0) {
+            return i + FindScalar(first + i, 4, value);
+        }
+    }
+    return i + FindScalar(first + i, count - i, value);
+}
+
+template <typename T>
+size_t CountNeon(const T *first, size_t count, T value) {
+    size_t i = 0;
+    uint32x4_t acc = vdupq_n_u32(0);
+    for (; i + 4 <= count; i += 4) {
+        // совпавшие элементы дают -1, поэтому вычитание маски прибавляет единицу
+        acc = vsubq_u32(acc, EqualMaskNeon(first + i, value));
+    }
+    return static_cast<size_t>(vaddlvq_u32(acc)) + CountScalar(first + i, count - i, value);
+}
+
+template <typename T>
+std::pair<T, T> MinMaxNeon(const T *first, size_t count) {
+    if (count < 4) {
+        return MinMaxScalar(first, count);
+    }
+    size_t i = 4;
+    std::pair<T, T> result;
+    if constexpr (std::is_same_v<T, float>) {
+        float32x4_t min = vld1q_f32(first);
+        float32x4_t max = min;
+        for (; i + 4 <= count; i += 4) {
+            const float32x4_t v = vld1q_f32(first + i);
+            min = vminq_f32(min, v);
+            max = vmaxq_f32(max, v);
+        }
+        result = {vminvq_f32(min), vmaxvq_f32(max)};
+    } else {
+        int32x4_t min = vld1q_s32(first);
+        int32x4_t max = min;
+        for (; i + 4 <= count; i += 4) {
+            const int32x4_t v = vld1q_s32(first + i);
+            min = vminq_s32(min, v);
+            max = vmaxq_s32(max, v);
+        }
+        result = {vminvq_s32(min), vmaxvq_s32(max)};
+    }
+    if (i < count) {
+        const auto tail = MinMaxScalar(first + i, count - i);
+        result.first = std::min(result.first, tail.first);
+        result.second = std::max(result.second, tail.second);
+    }
+    return result;
+}
+
+template <typename T>
+simd::SumType<T> SumNeon(const T *first, size_t count) {
+    size_t i = 0;
+    simd::SumType<T> sum{};
+    if constexpr (std::is_same_v<T, float>) {
+        float32x4_t acc = vdupq_n_f32(0.0f);
+        for (; i + 4 <= count; i += 4) {
+            acc = vaddq_f32(acc, vld1q_f32(first + i));
+        }
+        sum = vaddvq_f32(acc);
+    } else {
+        int64x2_t acc = vdupq_n_s64(0);
+        for (; i + 4 <= count; i += 4) {
+            acc = vpadalq_s32(acc, vld1q_s32(first + i));
+        }
+        sum = vaddvq_s64(acc);
+    }
+    return sum + SumScalar(first + i, count - i);
+}
+
+inline float DotNeon(const float *lhs, const float *rhs, size_t count) {
+    size_t i = 0;
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (; i + 4 <= count; i += 4) {
+        acc = vfmaq_f32(acc, vld1q_f32(lhs + i), vld1q_f32(rhs + i));
+    }
+    return vaddvq_f32(acc) + DotScalar(lhs + i, rhs + i, count - i);
+}
+
+#endif
+
+} // namespace
+
+namespace simd {
+
+inline Isa SupportedIsa() noexcept {
+#if defined(VECTOR_SIMD_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return Isa::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return Isa::AVX2;
+    }
+    return Isa::SCALAR;
+#elif defined(VECTOR_SIMD_NEON)
+    return Isa::NEON;
+#else
+    return Isa::SCALAR;
+#endif
+}
+
+// Хранит общий для программы набор инструкций, выбранный для функций модуля
+inline std::atomic<Isa>& IsaState() noexcept {
+    static std::atomic<Isa> isa{SupportedIsa()};
+    return isa;
+}
+
+inline Isa CurrentIsa() noexcept {
+    return IsaState().load(std::memory_order_relaxed);
+}
+
+inline void SetIsa(Isa isa) noexcept {
+    IsaState().store(std::min(isa, SupportedIsa()), std::memory_order_relaxed);
+}
+
+template <typename T>
+void Fill(T *first, size_t count, const T &value) {
+    if constexpr (IS_VECTORIZABLE<T>) {
+        switch (CurrentIsa()) {
+#if defined(VECTOR_SIMD_X86)
+        case Isa::AVX512:
+            return FillAvx512(first, count, value);
+        case Isa::AVX2:
+            return FillAvx2(first, count, value);
+#elif defined(VECTOR_SIMD_NEON)
+        case Isa::NEON:
+            return FillNeon(first, count, value);
+#endif
+        default:
+            break;
+        }
+    }
+    FillScalar(first, count, value);
+}
+
+template <typename T>
+size_t Find(const T *first, size_t count, const T &value) {
+    if constexpr (IS_VECTORIZABLE<T>) {
+        switch (CurrentIsa()) {
+#if defined(VECTOR_SIMD_X86)
+        case Isa::AVX512:
+            return FindAvx512(first, count, value);
+        case Isa::AVX2:
+            return FindAvx2(first, count, value);
+#elif defined(VECTOR_SIMD_NEON)
+        case Isa::NEON:
+            return FindNeon(first, count, value);
+#endif
+        default:
+            break;
+        }
+    }
+    return FindScalar(first, count, value);
+}
+
+template <typename T>
+size_t Count(const T *first, size_t count, const T &value) {
+    if constexpr (IS_VECTORIZABLE<T>) {
+        switch (CurrentIsa()) {
+#if defined(VECTOR_SIMD_X86)
+        case Isa::AVX512:
+            return CountAvx512(first, count, value);
+        case Isa::AVX2:
+            return CountAvx2(first, count, value);
+#elif defined(VECTOR_SIMD_NEON)
+        case Isa::NEON:
+            return CountNeon(first, count, value);
+#endif
+        default:
+            break;
+        }
+    }
+    return CountScalar(first, count, value);
+}
+
+template <typename T>
+std::pair<T, T> MinMax(const T *first, size_t count) {
+    assert(count > 0);
+    if constexpr (IS_VECTORIZABLE<T>) {
+        switch (CurrentIsa()) {
+#if defined(VECTOR_SIMD_X86)
+        case Isa::AVX512:
+            return MinMaxAvx512(first, count);
+        case Isa::AVX2:
+            return MinMaxAvx2(first, count);
+#elif defined(VECTOR_SIMD_NEON)
+        case Isa::NEON:
+            return MinMaxNeon(first, count);
+#endif
+        default:
+            break;
+        }
+    }
+    return MinMaxScalar(first, count);
+}
+
+template <typename T>
+SumType<T> Sum(const T *first, size_t count) {
+    if constexpr (IS_VECTORIZABLE<T>) {
+        switch (CurrentIsa()) {
+#if defined(VECTOR_SIMD_X86)
+        case Isa::AVX512:
+            return SumAvx512(first, count);
+        case Isa::AVX2:
+            return SumAvx2(first, count);
+#elif defined(VECTOR_SIMD_NEON)
+        case Isa::NEON:
+            return SumNeon(first, count);
+#endif
+        default:
+            break;
+        }
+    }
+    return SumScalar(first, count);
+}
+
+template <typename T>
+SumType<T> Dot(const T *lhs, const T *rhs, size_t count) {
+    // произведения int32_t накапливаются в int64_t, а расширяющее векторное умножение
+    // в AVX2 обрабатывает только чётные элементы, поэтому векторная реализация есть лишь для float
+    if constexpr (std::is_same_v<T, float>) {
+        switch (CurrentIsa()) {
+#if defined(VECTOR_SIMD_X86)
+        case Isa::AVX512:
+            return DotAvx512(lhs, rhs, count);
+        case Isa::AVX2:
+            return DotAvx2(lhs, rhs, count);
+#elif defined(VECTOR_SIMD_NEON)
+        case Isa::NEON:
+            return DotNeon(lhs, rhs, count);
+#endif
+        default:
+            break;
+        }
+    }
+    return DotScalar(lhs, rhs, count);
+}
+
+template <typename T, typename U, typename Operation>
+void Transform(const T *in, size_t count, U *out, Operation op) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = op(in[i]);
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Fill(Vector<T, Alloc, Growth> &vector, const T &value) {
+    Fill(vector.begin(), vector.Size(), value);
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::iterator Find(Vector<T, Alloc, Growth> &vector, const T &value) {
+    return vector.begin() + Find(vector.cbegin(), vector.Size(), value);
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::const_iterator Find(const Vector<T, Alloc, Growth> &vector, const T &value) {
+    return vector.begin() + Find(vector.begin(), vector.Size(), value);
+}
+
+template <typename T, typename Alloc, typename Growth>
+size_t Count(const Vector<T, Alloc, Growth> &vector, const T &value) {
+    return Count(vector.begin(), vector.Size(), value);
+}
+
+template <typename T, typename Alloc, typename Growth>
+std::pair<T, T> MinMax(const Vector<T, Alloc, Growth> &vector) {
+    return MinMax(vector.begin(), vector.Size());
+}
+
+template <typename T, typename Alloc, typename Growth>
+SumType<T> Sum(const Vector<T, Alloc, Growth> &vector) {
+    return Sum(vector.begin(), vector.Size());
+}
+
+template <typename T, typename Alloc, typename Growth>
+SumType<T> Dot(const Vector<T, Alloc, Growth> &lhs, const Vector<T, Alloc, Growth> &rhs) {
+    assert(lhs.Size() == rhs.Size());
+    return Dot(lhs.begin(), rhs.begin(), lhs.Size());
+}
+
+template <typename T, typename Alloc, typename Growth, typename Operation>
+void Transform(Vector<T, Alloc, Growth> &vector, Operation op) {
+    Transform(vector.begin(), vector.Size(), vector.begin(), op);
+}
+
+} // namespace simd
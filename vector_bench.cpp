@@ -0,0 +1,569 @@
+#include "vector.h"
+#include "vector_algorithms.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Максимальный размер контейнера в параметризованных бенчмарках.
+// По умолчанию ограничен, чтобы полный прогон укладывался в минуты;
+// для замеров до 10^8 элементов: -DVECTOR_BENCH_MAX_SIZE=100000000
+#ifndef VECTOR_BENCH_MAX_SIZE
+#define VECTOR_BENCH_MAX_SIZE (1 << 20)
+#endif
+
+// для квадратичных операций (вставка и удаление в начале и середине)
+#ifndef VECTOR_BENCH_MAX_SHIFT_SIZE
+#define VECTOR_BENCH_MAX_SHIFT_SIZE (1 << 12)
+#endif
+
+namespace {
+
+// ------------------------------- ALLOCATION COUNTERS ----------------------------------
+
+// Vector для тривиально переносимых типов берёт память через malloc/realloc,
+// поэтому на glibc подсчитываются вызовы malloc/realloc (operator new реализован через malloc),
+// на остальных платформах - только вызовы operator new
+std::atomic<size_t> allocation_count{0};
+std::atomic<size_t> allocated_bytes{0};
+
+void CountAllocation(size_t bytes) noexcept {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+} // namespace
+
+#if defined(__GLIBC__)
+
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_realloc(void *ptr, size_t size);
+void __libc_free(void *ptr);
+
+void* malloc(size_t size) noexcept {
+    CountAllocation(size);
+    return __libc_malloc(size);
+}
+
+void* realloc(void *ptr, size_t size) noexcept {
+    CountAllocation(size);
+    return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) noexcept {
+    __libc_free(ptr);
+}
+
+} // extern "C"
+
+#else
+
+void* operator new(size_t size) {
+    CountAllocation(size);
+    if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t /*size*/) noexcept {
+    std::free(ptr);
+}
+
+#endif
+
+namespace {
+
+// Снимок счётчиков аллокаций на начало замера
+class AllocationScope {
+public:
+    AllocationScope() noexcept
+        : count_(allocation_count.load(std::memory_order_relaxed))
+        , bytes_(allocated_bytes.load(std::memory_order_relaxed)) {
+    }
+
+    // аллокации между Pause и Resume (подготовка данных вне замера) не учитываются
+    void Pause() noexcept {
+        paused_count_ = allocation_count.load(std::memory_order_relaxed);
+        paused_bytes_ = allocated_bytes.load(std::memory_order_relaxed);
+    }
+
+    void Resume() noexcept {
+        count_ += allocation_count.load(std::memory_order_relaxed) - paused_count_;
+        bytes_ += allocated_bytes.load(std::memory_order_relaxed) - paused_bytes_;
+    }
+
+    // записывает среднее число аллокаций и выделенных байт на итерацию
+    void Report(benchmark::State &state) const {
+        const auto count = allocation_count.load(std::memory_order_relaxed) - count_;
+        const auto bytes = allocated_bytes.load(std::memory_order_relaxed) - bytes_;
+        state.counters["allocs/op"] = benchmark::Counter(static_cast<double>(count),
+                                                         benchmark::Counter::kAvgIterations);
+        state.counters["bytes/op"] = benchmark::Counter(static_cast<double>(bytes),
+                                                        benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    size_t count_;
+    size_t bytes_;
+    size_t paused_count_ = 0;
+    size_t paused_bytes_ = 0;
+};
+
+// ---------------------------------- ELEMENT TYPES -------------------------------------
+
+// 64-байтная тривиально копируемая структура
+struct Pod64 {
+    int64_t data[8] = {};
+};
+
+// некопируемый тип с nothrow-перемещением, не являющийся тривиально переносимым
+struct MoveOnly {
+    MoveOnly() = default;
+    explicit MoveOnly(size_t value) : data(std::make_unique<size_t>(value)) {}
+    MoveOnly(const MoveOnly&) = delete;
+    MoveOnly(MoveOnly &&other) noexcept : data(std::move(other.data)) {}
+    MoveOnly& operator=(const MoveOnly&) = delete;
+    MoveOnly& operator=(MoveOnly &&other) noexcept {
+        data = std::move(other.data);
+        return *this;
+    }
+    std::unique_ptr<size_t> data;
+};
+
+// тип, перемещение которого может выбросить исключение: при реаллокации элементы копируются
+struct ThrowingMove {
+    ThrowingMove() = default;
+    explicit ThrowingMove(size_t value) : data(std::to_string(value)) {}
+    ThrowingMove(const ThrowingMove&) = default;
+    ThrowingMove(ThrowingMove &&other) noexcept(false) : data(std::move(other.data)) {}
+    ThrowingMove& operator=(const ThrowingMove&) = default;
+    ThrowingMove& operator=(ThrowingMove &&other) noexcept(false) {
+        data = std::move(other.data);
+        return *this;
+    }
+    std::string data;
+};
+
+// целое с режимом проверки индекса MODE в operator[] вектора
+template <BoundsCheck MODE>
+struct BoundsChecked {
+    int value = 0;
+};
+
+} // namespace
+
+template <BoundsCheck MODE>
+struct VectorBoundsCheck<BoundsChecked<MODE>> : std::integral_constant<BoundsCheck, MODE> {};
+
+namespace {
+
+static_assert(IsTriviallyRelocatableV<Pod64>);
+static_assert(!IsTriviallyRelocatableV<MoveOnly>);
+static_assert(!std::is_nothrow_move_constructible_v<ThrowingMove>);
+
+template <typename T>
+T MakeValue(size_t i) {
+    if constexpr (std::is_same_v<T, int>) {
+        return static_cast<int>(i);
+    } else if constexpr (std::is_same_v<T, Pod64>) {
+        Pod64 value;
+        value.data[0] = static_cast<int64_t>(i);
+        return value;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        // строка длиннее буфера SSO, чтобы каждый элемент владел памятью в куче
+        return "benchmark string number " + std::to_string(i);
+    } else {
+        return T(i);
+    }
+}
+
+// ----------------------------------- CONTAINERS ---------------------------------------
+
+// Единый интерфейс к Vector и std::vector для общих бенчмарков
+template <typename T>
+struct VectorOps {
+    using Container = Vector<T>;
+
+    static void PushBack(Container &c, T &&value) {
+        c.PushBack(std::move(value));
+    }
+    static void EmplaceBack(Container &c) {
+        c.EmplaceBack();
+    }
+    static void InsertAt(Container &c, size_t index, T &&value) {
+        c.Insert(c.cbegin() + index, std::move(value));
+    }
+    static void EraseAt(Container &c, size_t index) {
+        c.Erase(c.cbegin() + index);
+    }
+    static void Reserve(Container &c, size_t capacity) {
+        c.Reserve(capacity);
+    }
+    static size_t Size(const Container &c) {
+        return c.Size();
+    }
+};
+
+template <typename T>
+struct StdVectorOps {
+    using Container = std::vector<T>;
+
+    static void PushBack(Container &c, T &&value) {
+        c.push_back(std::move(value));
+    }
+    static void EmplaceBack(Container &c) {
+        c.emplace_back();
+    }
+    static void InsertAt(Container &c, size_t index, T &&value) {
+        c.insert(c.cbegin() + static_cast<std::ptrdiff_t>(index), std::move(value));
+    }
+    static void EraseAt(Container &c, size_t index) {
+        c.erase(c.cbegin() + static_cast<std::ptrdiff_t>(index));
+    }
+    static void Reserve(Container &c, size_t capacity) {
+        c.reserve(capacity);
+    }
+    static size_t Size(const Container &c) {
+        return c.size();
+    }
+};
+
+template <typename Ops, typename T>
+typename Ops::Container MakeFilled(size_t count) {
+    typename Ops::Container c;
+    Ops::Reserve(c, count);
+    for (size_t i = 0; i < count; ++i) {
+        Ops::PushBack(c, MakeValue<T>(i));
+    }
+    return c;
+}
+
+size_t RangeSize(const benchmark::State &state) {
+    return static_cast<size_t>(state.range(0));
+}
+
+void SetProcessed(benchmark::State &state, size_t items_per_iteration) {
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(items_per_iteration));
+}
+
+// ----------------------------------- BENCHMARKS ---------------------------------------
+
+template <typename Ops, typename T>
+void BM_PushBack(benchmark::State &state) {
+    const size_t count = RangeSize(state);
+    AllocationScope allocations;
+    for (auto _ : state) {
+        typename Ops::Container c;
+        for (size_t i = 0; i < count; ++i) {
+            Ops::PushBack(c, MakeValue<T>(i));
+        }
+        benchmark::DoNotOptimize(&c);
+    }
+    allocations.Report(state);
+    SetProcessed(state, count);
+}
+
+template <typename Ops, typename T>
+void BM_EmplaceBack(benchmark::State &state) {
+    const size_t count = RangeSize(state);
+    AllocationScope allocations;
+    for (auto _ : state) {
+        typename Ops::Container c;
+        for (size_t i = 0; i < count; ++i) {
+            Ops::EmplaceBack(c);
+        }
+        benchmark::DoNotOptimize(&c);
+    }
+    allocations.Report(state);
+    SetProcessed(state, count);
+}
+
+template <typename Ops, typename T>
+void BM_ReservePushBack(benchmark::State &state) {
+    const size_t count = RangeSize(state);
+    AllocationScope allocations;
+    for (auto _ : state) {
+        typename Ops::Container c;
+        Ops::Reserve(c, count);
+        for (size_t i = 0; i < count; ++i) {
+            Ops::PushBack(c, MakeValue<T>(i));
+        }
+        benchmark::DoNotOptimize(&c);
+    }
+    allocations.Report(state);
+    SetProcessed(state, count);
+}
+
+// вставка count элементов в позицию index_num / index_den от текущего размера
+template <typename Ops, typename T, size_t INDEX_NUM, size_t INDEX_DEN>
+void BM_Insert(benchmark::State &state) {
+    const size_t count = RangeSize(state);
+    AllocationScope allocations;
+    for (auto _ : state) {
+        typename Ops::Container c;
+        for (size_t i = 0; i < count; ++i) {
+            Ops::InsertAt(c, Ops::Size(c) * INDEX_NUM / INDEX_DEN, MakeValue<T>(i));
+        }
+        benchmark::DoNotOptimize(&c);
+    }
+    allocations.Report(state);
+    SetProcessed(state, count);
+}
+
+// удаление всех элементов по одному из позиции index_num / index_den от текущего размера
+template <typename Ops, typename T, size_t INDEX_NUM, size_t INDEX_DEN>
+void BM_Erase(benchmark::State &state) {
+    const size_t count = RangeSize(state);
+    AllocationScope allocations;
+    for (auto _ : state) {
+        state.PauseTiming();
+        allocations.Pause();
+        auto c = MakeFilled<Ops, T>(count);
+        allocations.Resume();
+        state.ResumeTiming();
+        while (Ops::Size(c) > 0) {
+            Ops::EraseAt(c, (Ops::Size(c) - 1) * INDEX_NUM / INDEX_DEN);
+        }
+        benchmark::DoNotOptimize(&c);
+    }
+    allocations.Report(state);
+    SetProcessed(state, count);
+}
+
+template <typename Ops, typename T>
+void BM_CopyAssign(benchmark::State &state) {
+    const size_t count = RangeSize(state);
+    const auto source = MakeFilled<Ops, T>(count);
+    AllocationScope allocations;
+    for (auto _ : state) {
+        typename Ops::Container c;
+        c = source;
+        benchmark::DoNotOptimize(&c);
+    }
+    allocations.Report(state);
+    SetProcessed(state, count);
+}
+
+template <typename Ops, typename T>
+void BM_MoveAssign(benchmark::State &state) {
+    const size_t count = RangeSize(state);
+    auto source = MakeFilled<Ops, T>(count);
+    typename Ops::Container target;
+    AllocationScope allocations;
+    for (auto _ : state) {
+        target = std::move(source);
+        source = std::move(target);
+        benchmark::DoNotOptimize(&source);
+    }
+    allocations.Report(state);
+    SetProcessed(state, 2);
+}
+
+template <typename Ops, typename T>
+void BM_Iterate(benchmark::State &state) {
+    const size_t count = RangeSize(state);
+    auto c = MakeFilled<Ops, T>(count);
+    AllocationScope allocations;
+    for (auto _ : state) {
+        for (auto &elem : c) {
+            benchmark::DoNotOptimize(&elem);
+        }
+        benchmark::ClobberMemory();
+    }
+    allocations.Report(state);
+    SetProcessed(state, count);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(count * sizeof(T)));
+}
+
+// Сумма элементов по индексам 0..count-1 через operator[] с режимом проверки MODE
+template <BoundsCheck MODE>
+void BM_IndexSum(benchmark::State &state) {
+    const size_t count = RangeSize(state);
+    Vector<BoundsChecked<MODE>> v(count);
+    for (size_t i = 0; i < count; ++i) {
+        v[i].value = static_cast<int>(i % 1000);
+    }
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (size_t i = 0; i < v.Size(); ++i) {
+            sum += v[i].value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    SetProcessed(state, count);
+}
+
+// Сумма элементов по псевдослучайным индексам: проверку нельзя вынести из цикла
+template <BoundsCheck MODE>
+void BM_IndexGather(benchmark::State &state) {
+    const size_t count = RangeSize(state);
+    Vector<BoundsChecked<MODE>> v(count);
+    Vector<uint32_t> indices(count);
+    uint64_t seed = 88172645463325252ULL;
+    for (size_t i = 0; i < count; ++i) {
+        v[i].value = static_cast<int>(i % 1000);
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        indices[i] = static_cast<uint32_t>(seed % count);
+    }
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (const uint32_t index : indices) {
+            sum += v[index].value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    SetProcessed(state, count);
+}
+
+// операция op из модуля simd над вектором из count элементов с набором инструкций isa
+template <typename T, typename Operation>
+void BM_Simd(benchmark::State &state, simd::Isa isa, Operation op) {
+    const size_t count = RangeSize(state);
+    Vector<T> v(count);
+    for (size_t i = 0; i < count; ++i) {
+        v[i] = static_cast<T>(i % 1000);
+    }
+    simd::SetIsa(isa);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(op(v));
+    }
+    simd::SetIsa(simd::SupportedIsa());
+    SetProcessed(state, count);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(count * sizeof(T)));
+}
+
+// --------------------------------- REGISTRATION ---------------------------------------
+
+template <typename Function>
+void Register(const std::string &name, Function function, int64_t max_size) {
+    benchmark::RegisterBenchmark(name.c_str(), function)
+        ->RangeMultiplier(8)
+        ->Range(8, max_size);
+}
+
+template <template <typename> class Ops, typename T>
+void RegisterContainer(const std::string &container, const std::string &type) {
+    using O = Ops<T>;
+    const auto suffix = "/" + container + "<" + type + ">";
+    const int64_t max_size = VECTOR_BENCH_MAX_SIZE;
+    const int64_t max_shift_size = VECTOR_BENCH_MAX_SHIFT_SIZE;
+
+    Register("PushBack" + suffix, BM_PushBack<O, T>, max_size);
+    Register("ReservePushBack" + suffix, BM_ReservePushBack<O, T>, max_size);
+    Register("InsertFront" + suffix, BM_Insert<O, T, 0, 1>, max_shift_size);
+    Register("InsertMiddle" + suffix, BM_Insert<O, T, 1, 2>, max_shift_size);
+    Register("EraseFront" + suffix, BM_Erase<O, T, 0, 1>, max_shift_size);
+    Register("EraseMiddle" + suffix, BM_Erase<O, T, 1, 2>, max_shift_size);
+    Register("EraseBack" + suffix, BM_Erase<O, T, 1, 1>, max_size);
+    Register("MoveAssign" + suffix, BM_MoveAssign<O, T>, max_size);
+    Register("Iterate" + suffix, BM_Iterate<O, T>, max_size);
+    if constexpr (std::is_default_constructible_v<T>) {
+        Register("EmplaceBack" + suffix, BM_EmplaceBack<O, T>, max_size);
+    }
+    if constexpr (std::is_copy_constructible_v<T>) {
+        Register("CopyAssign" + suffix, BM_CopyAssign<O, T>, max_size);
+    }
+}
+
+template <typename T>
+void RegisterType(const std::string &type) {
+    RegisterContainer<VectorOps, T>("Vector", type);
+    RegisterContainer<StdVectorOps, T>("std::vector", type);
+}
+
+template <typename T>
+void RegisterSimd(const std::string &type) {
+    static const std::pair<simd::Isa, const char*> ISA_NAMES[] = {
+        {simd::Isa::SCALAR, "scalar"},
+        {simd::Isa::NEON, "neon"},
+        {simd::Isa::AVX2, "avx2"},
+        {simd::Isa::AVX512, "avx512"},
+    };
+    const int64_t max_size = VECTOR_BENCH_MAX_SIZE;
+    for (const auto &[isa, isa_name] : ISA_NAMES) {
+        // помимо скалярной замеряются все реализации, доступные на процессоре
+        const bool available = isa == simd::Isa::SCALAR || isa == simd::SupportedIsa()
+                               || (isa == simd::Isa::AVX2 && simd::SupportedIsa() == simd::Isa::AVX512);
+        if (!available) {
+            continue;
+        }
+        const auto suffix = std::string("/") + isa_name + "/" + type;
+        Register("SimdFill" + suffix, [isa = isa](benchmark::State &state) {
+            BM_Simd<T>(state, isa, [](Vector<T> &v) {
+                simd::Fill(v, T(1));
+                return v.begin();
+            });
+        }, max_size);
+        Register("SimdFind" + suffix, [isa = isa](benchmark::State &state) {
+            BM_Simd<T>(state, isa, [](const Vector<T> &v) {
+                return simd::Find(v, T(-1));
+            });
+        }, max_size);
+        Register("SimdCount" + suffix, [isa = isa](benchmark::State &state) {
+            BM_Simd<T>(state, isa, [](const Vector<T> &v) {
+                return simd::Count(v, T(7));
+            });
+        }, max_size);
+        Register("SimdMinMax" + suffix, [isa = isa](benchmark::State &state) {
+            BM_Simd<T>(state, isa, [](const Vector<T> &v) {
+                return simd::MinMax(v);
+            });
+        }, max_size);
+        Register("SimdSum" + suffix, [isa = isa](benchmark::State &state) {
+            BM_Simd<T>(state, isa, [](const Vector<T> &v) {
+                return simd::Sum(v);
+            });
+        }, max_size);
+        Register("SimdDot" + suffix, [isa = isa](benchmark::State &state) {
+            BM_Simd<T>(state, isa, [](const Vector<T> &v) {
+                return simd::Dot(v, v);
+            });
+        }, max_size);
+    }
+}
+
+template <BoundsCheck MODE>
+void RegisterBoundsCheck(const std::string &mode) {
+    const int64_t max_size = VECTOR_BENCH_MAX_SIZE;
+    Register("IndexSum/" + mode, BM_IndexSum<MODE>, max_size);
+    Register("IndexGather/" + mode, BM_IndexGather<MODE>, max_size);
+}
+
+} // namespace
+
+// Результаты для отслеживания регрессий выводятся в JSON:
+// ./vector_bench --benchmark_format=json  или  --benchmark_out=result.json
+int main(int argc, char **argv) {
+    RegisterType<int>("int");
+    RegisterType<Pod64>("Pod64");
+    RegisterType<std::string>("string");
+    RegisterType<MoveOnly>("MoveOnly");
+    RegisterType<ThrowingMove>("ThrowingMove");
+    RegisterSimd<int32_t>("int32_t");
+    RegisterSimd<float>("float");
+    RegisterBoundsCheck<BoundsCheck::NONE>("none");
+    RegisterBoundsCheck<BoundsCheck::TRAP>("trap");
+    RegisterBoundsCheck<BoundsCheck::THROW>("throw");
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,290 @@
+#pragma once
+#include "vector.h"
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+// -------------------------------- SERIALIZATION ---------------------------------------
+
+/* Двоичный формат: заголовок и элементы.
+   Заголовок (порядок байт платформы): сигнатура (4 байта), версия формата (2 байта),
+   флаги (2 байта), размер элемента в байтах (4 байта) и число элементов (8 байт).
+   Тривиально копируемые элементы записываются одним блоком байтов без преобразований
+   (флаг FLAG_RAW_ELEMENTS), остальные - поэлементно при помощи ElementSerializer */
+
+inline constexpr uint32_t SERIALIZATION_MAGIC = 0x31434556;  // "VEC1"
+inline constexpr uint16_t SERIALIZATION_VERSION = 1;
+// размер порции, которой VectorReader читает элементы
+inline constexpr size_t SERIALIZATION_CHUNK_BYTES = size_t{1} << 20;
+
+class SerializationError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Запись и чтение отдельного элемента для типов, которые нельзя скопировать байтами.
+// Для собственных типов специализируйте шаблон, определив
+//   static void Write(std::ostream &out, const T &value);
+//   static T Read(std::istream &in);
+template <typename T, typename = void>
+struct ElementSerializer {
+    static_assert(std::is_trivially_copyable_v<T>, "Specialize ElementSerializer for this type");
+
+    static void Write(std::ostream &out, const T &value);
+    static T Read(std::istream &in);
+};
+
+template <typename Char, typename Traits, typename StrAlloc>
+struct ElementSerializer<std::basic_string<Char, Traits, StrAlloc>> {
+    using String = std::basic_string<Char, Traits, StrAlloc>;
+
+    static void Write(std::ostream &out, const String &value);
+    static String Read(std::istream &in);
+};
+
+// Вложенные векторы записываются вместе со своими заголовками
+template <typename T, typename Alloc, typename Growth>
+struct ElementSerializer<Vector<T, Alloc, Growth>> {
+    static void Write(std::ostream &out, const Vector<T, Alloc, Growth> &value);
+    static Vector<T, Alloc, Growth> Read(std::istream &in);
+};
+
+// Записывает вектор в поток. Тривиально копируемые элементы записываются одним вызовом write
+template <typename T, typename Alloc, typename Growth>
+void Serialize(std::ostream &out, const Vector<T, Alloc, Growth> &vector);
+
+// Заменяет содержимое vector элементами из потока. Ёмкость растёт вдвое по мере чтения порций,
+// но не больше числа элементов из заголовка, поэтому повреждённый заголовок не приводит
+// к огромному выделению памяти.
+// Тип тривиально копируемых элементов проверяется только по размеру.
+// При ошибке формата или чтения выбрасывает SerializationError, vector остаётся в согласованном
+// состоянии с частью прочитанных элементов
+template <typename T, typename Alloc, typename Growth>
+void Deserialize(std::istream &in, Vector<T, Alloc, Growth> &vector);
+
+// Потоковое чтение вектора порциями: конструктор читает и проверяет заголовок,
+// ReadChunk дописывает в конец out очередную порцию элементов
+template <typename T>
+class VectorReader {
+public:
+    explicit VectorReader(std::istream &in);
+
+    // число элементов в потоке и ещё не прочитанных элементов
+    size_t Size() const noexcept;
+    size_t Remaining() const noexcept;
+
+    // Читает не более max_count элементов в конец out и возвращает число прочитанных
+    template <typename Alloc, typename Growth>
+    size_t ReadChunk(Vector<T, Alloc, Growth> &out, size_t max_count = DEFAULT_CHUNK);
+    // Читает все оставшиеся элементы порциями по chunk элементов. Ёмкость out растёт вдвое
+    // по мере чтения, но не больше, чем нужно для оставшихся элементов; заранее по заголовку
+    // она не резервируется
+    template <typename Alloc, typename Growth>
+    void ReadAll(Vector<T, Alloc, Growth> &out, size_t chunk = DEFAULT_CHUNK);
+
+private:
+    static constexpr bool RAW_ELEMENTS = std::is_trivially_copyable_v<T>;
+    static constexpr size_t DEFAULT_CHUNK = std::max<size_t>(1, SERIALIZATION_CHUNK_BYTES / sizeof(T));
+
+    std::istream &in_;
+    size_t size_ = 0;
+    size_t remaining_ = 0;
+
+}; // class VectorReader
+
+namespace {
+
+enum SerializationFlags : uint16_t {
+    FLAG_RAW_ELEMENTS = 1,
+};
+
+inline void WriteBytes(std::ostream &out, const void *data, size_t bytes) {
+    if (bytes > 0 && !out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes))) {
+        throw SerializationError("Failed to write vector data");
+    }
+}
+
+// возвращает число прочитанных байтов (меньше bytes при преждевременном конце потока)
+inline size_t ReadSomeBytes(std::istream &in, void *data, size_t bytes) {
+    if (bytes == 0) {
+        return 0;
+    }
+    in.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes));
+    return static_cast<size_t>(in.gcount());
+}
+
+inline void ReadBytes(std::istream &in, void *data, size_t bytes) {
+    if (ReadSomeBytes(in, data, bytes) != bytes) {
+        throw SerializationError("Unexpected end of vector data");
+    }
+}
+
+template <typename T>
+void WriteValue(std::ostream &out, const T &value) {
+    WriteBytes(out, &value, sizeof(T));
+}
+
+template <typename T>
+T ReadValue(std::istream &in) {
+    T value;
+    ReadBytes(in, &value, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void WriteHeader(std::ostream &out, size_t count) {
+    constexpr bool raw = std::is_trivially_copyable_v<T>;
+    WriteValue(out, SERIALIZATION_MAGIC);
+    WriteValue(out, SERIALIZATION_VERSION);
+    WriteValue(out, static_cast<uint16_t>(raw ? FLAG_RAW_ELEMENTS : 0));
+    WriteValue(out, static_cast<uint32_t>(raw ? sizeof(T) : 0));
+    WriteValue(out, static_cast<uint64_t>(count));
+}
+
+// проверяет заголовок и возвращает число элементов
+template <typename T>
+size_t ReadHeader(std::istream &in) {
+    constexpr bool raw = std::is_trivially_copyable_v<T>;
+    if (ReadValue<uint32_t>(in) != SERIALIZATION_MAGIC) {
+        throw SerializationError("Not a serialized vector or byte order mismatch");
+    }
+    if (ReadValue<uint16_t>(in) != SERIALIZATION_VERSION) {
+        throw SerializationError("Unsupported vector serialization version");
+    }
+    const auto flags = ReadValue<uint16_t>(in);
+    const auto elem_size = ReadValue<uint32_t>(in);
+    if (((flags & FLAG_RAW_ELEMENTS) != 0) != raw || elem_size != (raw ? sizeof(T) : 0)) {
+        throw SerializationError("Serialized element type does not match");
+    }
+    const auto count = ReadValue<uint64_t>(in);
+    if (count > std::numeric_limits<size_t>::max()) {
+        throw SerializationError("Serialized vector is too large");
+    }
+    return static_cast<size_t>(count);
+}
+
+} // namespace
+
+template <typename T, typename Enable>
+void ElementSerializer<T, Enable>::Write(std::ostream &out, const T &value) {
+    WriteValue(out, value);
+}
+
+template <typename T, typename Enable>
+T ElementSerializer<T, Enable>::Read(std::istream &in) {
+    return ReadValue<T>(in);
+}
+
+template <typename Char, typename Traits, typename StrAlloc>
+void ElementSerializer<std::basic_string<Char, Traits, StrAlloc>>::Write(std::ostream &out, const String &value) {
+    WriteValue(out, static_cast<uint64_t>(value.size()));
+    WriteBytes(out, value.data(), value.size() * sizeof(Char));
+}
+
+template <typename Char, typename Traits, typename StrAlloc>
+typename ElementSerializer<std::basic_string<Char, Traits, StrAlloc>>::String
+ElementSerializer<std::basic_string<Char, Traits, StrAlloc>>::Read(std::istream &in) {
+    const auto length = ReadValue<uint64_t>(in);
+    String value;
+    // строка растёт порциями, чтобы повреждённая длина не приводила к огромному выделению памяти
+    for (uint64_t done = 0; done < length;) {
+        const size_t part = static_cast<size_t>(std::min<uint64_t>(length - done, SERIALIZATION_CHUNK_BYTES));
+        const size_t old_size = value.size();
+        value.resize(old_size + part);
+        ReadBytes(in, value.data() + old_size, part * sizeof(Char));
+        done += part;
+    }
+    return value;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void ElementSerializer<Vector<T, Alloc, Growth>>::Write(std::ostream &out, const Vector<T, Alloc, Growth> &value) {
+    Serialize(out, value);
+}
+
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth> ElementSerializer<Vector<T, Alloc, Growth>>::Read(std::istream &in) {
+    Vector<T, Alloc, Growth> value;
+    Deserialize(in, value);
+    return value;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Serialize(std::ostream &out, const Vector<T, Alloc, Growth> &vector) {
+    WriteHeader<T>(out, vector.Size());
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        WriteBytes(out, vector.begin(), vector.Size() * sizeof(T));
+    } else {
+        for (const T &elem : vector) {
+            ElementSerializer<T>::Write(out, elem);
+        }
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Deserialize(std::istream &in, Vector<T, Alloc, Growth> &vector) {
+    VectorReader<T> reader(in);
+    vector.Clear();
+    reader.ReadAll(vector);
+}
+
+template <typename T>
+VectorReader<T>::VectorReader(std::istream &in)
+    : in_(in)
+    , size_(ReadHeader<T>(in))
+    , remaining_(size_)  //
+{
+}
+
+template <typename T>
+size_t VectorReader<T>::Size() const noexcept {
+    return size_;
+}
+
+template <typename T>
+size_t VectorReader<T>::Remaining() const noexcept {
+    return remaining_;
+}
+
+template <typename T>
+template <typename Alloc, typename Growth>
+size_t VectorReader<T>::ReadChunk(Vector<T, Alloc, Growth> &out, size_t max_count) {
+    const size_t count = std::min(max_count, remaining_);
+    if constexpr (RAW_ELEMENTS) {
+        // байты читаются прямо в буфер вектора, без инициализации новых элементов
+        const size_t old_size = out.Size();
+        out.ResizeForOverwrite(old_size + count);
+        const size_t bytes = ReadSomeBytes(in_, out.begin() + old_size, count * sizeof(T));
+        if (bytes != count * sizeof(T)) {
+            out.Resize(old_size + bytes / sizeof(T));
+            remaining_ -= bytes / sizeof(T);
+            throw SerializationError("Unexpected end of vector data");
+        }
+        remaining_ -= count;
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            out.EmplaceBack(ElementSerializer<T>::Read(in_));
+            --remaining_;
+        }
+    }
+    return count;
+}
+
+template <typename T>
+template <typename Alloc, typename Growth>
+void VectorReader<T>::ReadAll(Vector<T, Alloc, Growth> &out, size_t chunk) {
+    assert(chunk > 0);
+    while (remaining_ > 0) {
+        // Ёмкость растёт вдвое по мере чтения порций, но не больше объявленного числа элементов.
+        // Заранее по заголовку она не резервируется, чтобы повреждённое число элементов не
+        // приводило к огромному выделению памяти
+        const size_t needed = out.Size() + std::min(chunk, remaining_);
+        if (needed > out.Capacity()) {
+            out.Reserve(std::min(out.Size() + remaining_, std::max(needed, out.Capacity() * 2)));
+        }
+        ReadChunk(out, chunk);
+    }
+}